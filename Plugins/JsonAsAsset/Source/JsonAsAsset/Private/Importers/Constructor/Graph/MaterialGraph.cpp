@@ -39,7 +39,7 @@ TSharedPtr<FJsonObject> IMaterialGraph::FindMaterialData(UObject* Parent, const
 		}
 
 		/* Add to the list of expressions */
-		Container.Exports.Add(FUObjectExport(
+		Container.Add(FUObjectExport(
 			ExportName,
 			FName(ExportType),
 			FName(Outer),
@@ -0,0 +1,82 @@
+/* Copyright JsonAsAsset Contributors 2024-2025 */
+
+#include "Importers/Constructor/ImportBatch.h"
+
+#include "ContentBrowserModule.h"
+#include "IContentBrowserSingleton.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/Package.h"
+#include "Utilities/AssetUtilities.h"
+#include "Utilities/Compatibility.h"
+
+FImportBatch* FImportBatch::ActiveBatch = nullptr;
+
+FImportBatch::FImportBatch() : PreviousBatch(ActiveBatch) {
+	check(IsInGameThread());
+
+	ActiveBatch = this;
+}
+
+FImportBatch::~FImportBatch() {
+	/* Never drop the assets of a batch that was not finished explicitly */
+	Finish();
+
+	ActiveBatch = PreviousBatch;
+}
+
+FImportBatch* FImportBatch::Get() {
+	return ActiveBatch;
+}
+
+void FImportBatch::AddCreatedAsset(UObject* Asset) {
+	CreatedAssets.Add(Asset);
+}
+
+void FImportBatch::AddPackageToSave(UPackage* Package) {
+	bool bAlreadyQueued = false;
+	QueuedPackages.Add(Package, &bAlreadyQueued);
+
+	if (!bAlreadyQueued) {
+		PackagesToSave.Add(Package);
+	}
+}
+
+void FImportBatch::AddResult(const bool bSuccessful) {
+	(bSuccessful ? NumImported : NumFailed)++;
+}
+
+void FImportBatch::Finish() {
+	/* The asset registry and the content browser are updated once for the whole batch */
+	TArray<FAssetData> Assets;
+	Assets.Reserve(CreatedAssets.Num());
+
+	for (const TWeakObjectPtr<UObject>& Asset : CreatedAssets) {
+		if (UObject* CreatedAsset = Asset.Get()) {
+			FAssetRegistryModule::AssetCreated(CreatedAsset);
+			Assets.Add(FAssetData(CreatedAsset));
+		}
+	}
+
+	if (Assets.Num() > 0) {
+		const FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+		ContentBrowserModule.Get().SyncBrowserToAssets(Assets);
+	}
+
+	/* Packages are saved after every asset exists, so each package is written once even if later imports modified it */
+	if (PackagesToSave.Num() > 0) {
+		FScopedSlowTask SlowTask(PackagesToSave.Num(), FText::FromString("Saving imported assets"));
+		SlowTask.MakeDialog();
+
+		for (const TWeakObjectPtr<UPackage>& Package : PackagesToSave) {
+			SlowTask.EnterProgressFrame();
+
+			if (UPackage* PackageToSave = Package.Get()) {
+				FAssetUtilities::SavePackage(PackageToSave);
+			}
+		}
+	}
+
+	CreatedAssets.Empty();
+	PackagesToSave.Empty();
+	QueuedPackages.Empty();
+}
@@ -18,6 +18,7 @@
 #include "Styling/SlateIconFinder.h"
 
 #include "Importers/Types/DataAssetImporter.h"
+#include "Importers/Constructor/ImportBatch.h"
 
 /* Templated Class */
 #include "Importers/Constructor/TextureImporter.h"
@@ -198,6 +199,13 @@ bool IImporter::ReadExportsAndImport(TArray<TSharedPtr<FJsonValue>> Exports, FSt
 		}
 
 		if (LocalPackage == nullptr) {
+			if (FImportBatch* Batch = FImportBatch::Get()) {
+				Batch->AddResult(false);
+				GetMessageLog().Error(FText::FromString("Failed to import asset: " + Name + " (" + Type + "): " + FailureReason));
+
+				return false;
+			}
+
 			AppendNotification(
 				FText::FromString("Import Failed: " + Type),
 				FText::FromString(FailureReason),
@@ -251,6 +259,23 @@ bool IImporter::ReadExportsAndImport(TArray<TSharedPtr<FJsonValue>> Exports, FSt
 			return Successful;
 		}
 
+		/* Batched imports are summarized once the batch is finished, so only record the result */
+		if (FImportBatch* Batch = FImportBatch::Get()) {
+			Batch->AddResult(Successful);
+
+			if (Successful) {
+				UE_LOG(LogJsonAsAsset, Log, TEXT("Successfully imported \"%s\" as \"%s\""), *Name, *Type);
+
+				if (Type != "AnimSequence" && Type != "AnimMontage") {
+					Importer->SavePackage();
+				}
+			} else {
+				GetMessageLog().Error(FText::FromString("Failed to import asset: " + Name + " (" + Type + ")"));
+			}
+
+			continue;
+		}
+
 		if (Successful) {
 			UE_LOG(LogJsonAsAsset, Log, TEXT("Successfully imported \"%s\" as \"%s\""), *Name, *Type);
 
@@ -331,7 +356,14 @@ TArray<TSharedPtr<FJsonValue>> IImporter::FilterObjectsWithoutMatchingPropertyNa
 }
 
 bool IImporter::HandleAssetCreation(UObject* Asset) const {
-	FAssetRegistryModule::AssetCreated(Asset);
+	/* Imports of a batch announce their assets and browse to them once the batch is finished */
+	FImportBatch* Batch = FImportBatch::Get();
+
+	if (Batch) {
+		Batch->AddCreatedAsset(Asset);
+	} else {
+		FAssetRegistryModule::AssetCreated(Asset);
+	}
 	
 	if (!Asset->MarkPackageDirty()) return false;
 	
@@ -342,9 +374,11 @@ bool IImporter::HandleAssetCreation(UObject* Asset) const {
 	Package->FullyLoad();
 
 	/* Browse to newly added Asset in the Content Browser */
-	const TArray<FAssetData>& Assets = { Asset };
-	const FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
-	ContentBrowserModule.Get().SyncBrowserToAssets(Assets);
+	if (!Batch) {
+		const TArray<FAssetData>& Assets = { Asset };
+		const FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+		ContentBrowserModule.Get().SyncBrowserToAssets(Assets);
+	}
 
 	Asset->PostLoad();
 	
@@ -490,22 +524,14 @@ void IImporter::SavePackage() const {
 		return;
 	}
 
-	const FString PackageName = Package->GetName();
-	const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
-
 	/* User option to save packages on import */
 	if (Settings->AssetSettings.bSavePackagesOnImport) {
-#if ENGINE_UE5
-		FSavePackageArgs SaveArgs; {
-			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-			SaveArgs.Error = GError;
-			SaveArgs.SaveFlags = SAVE_NoError;
+		/* Packages of a batch are saved together once every asset of the batch exists */
+		if (FImportBatch* Batch = FImportBatch::Get()) {
+			Batch->AddPackageToSave(Package);
+		} else {
+			FAssetUtilities::SavePackage(Package);
 		}
-		
-		UPackage::SavePackage(Package, nullptr, *PackageFileName, SaveArgs);
-#else
-		UPackage::SavePackage(Package, nullptr, RF_Standalone, *PackageFileName);
-#endif
 	}
 }
 
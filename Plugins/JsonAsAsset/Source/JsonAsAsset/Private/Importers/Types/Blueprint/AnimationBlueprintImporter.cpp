@@ -411,7 +411,7 @@ void IAnimationBlueprintImporter::CreateAnimGraphNodes(UEdGraph* AnimGraph, cons
 
 		/* Only add json object data, transition result is handled different */
 		if (NodeType == "AnimGraphNode_TransitionResult") {
-			OutContainer.Exports.Add(
+			OutContainer.Add(
 				FUObjectExport(
 					FName(*Key),
 					FName(*NodeType),
@@ -443,7 +443,7 @@ void IAnimationBlueprintImporter::CreateAnimGraphNodes(UEdGraph* AnimGraph, cons
 		Node->NodeGuid = NodeGuid;
 
 		/* Add new node */
-		OutContainer.Exports.Add(
+		OutContainer.Add(
 			FUObjectExport(
 				FName(*Key),
 				FName(*NodeType),
@@ -213,7 +213,7 @@ inline void CreateStateMachineGraph(
 
 		FEdGraphUtilities::RenameGraphToNameOrCloseToName(BoundGraph, *StateName);
 
-		Container.Exports.Add(
+		Container.Add(
 			FUObjectExport(
 				FName(*StateName),
 				NAME_None,
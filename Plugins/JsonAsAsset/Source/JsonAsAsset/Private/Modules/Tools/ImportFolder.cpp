@@ -0,0 +1,209 @@
+/* Copyright JsonAsAsset Contributors 2024-2025 */
+
+#include "Modules/Tools/ImportFolder.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Importers/Constructor/Importer.h"
+#include "Importers/Constructor/ImportBatch.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Modules/CloudModule.h"
+#include "Modules/LogCategory.h"
+#include "Utilities/EngineUtilities.h"
+
+/* Normalizes a path to the key files are looked up by, the full path without extension */
+static FString GetPackageKey(FString Path) {
+	FPaths::NormalizeFilename(Path);
+	Path = FPaths::ConvertRelativePathToFull(Path);
+
+	return FPaths::SetExtension(Path, TEXT("")).ToLower();
+}
+
+/* Collects the packages referenced by object paths, e.g. "Game/Content/Materials/M_Rock.0" */
+static void CollectReferencedPackages(const TSharedPtr<FJsonValue>& Value, const FString& ExportDirectory, TSet<FString>& OutPackageKeys) {
+	if (!Value.IsValid()) return;
+
+	if (Value->Type == EJson::Array) {
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray()) {
+			CollectReferencedPackages(Element, ExportDirectory, OutPackageKeys);
+		}
+
+		return;
+	}
+
+	if (Value->Type != EJson::Object) return;
+
+	const TSharedPtr<FJsonObject> Object = Value->AsObject();
+
+	for (const auto& Pair : Object->Values) {
+		if (Pair.Key == TEXT("ObjectPath") && Pair.Value.IsValid() && Pair.Value->Type == EJson::String) {
+			FString PackagePath = Pair.Value->AsString();
+			PackagePath.Split(".", &PackagePath, nullptr, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+
+			if (!PackagePath.IsEmpty()) {
+				OutPackageKeys.Add(GetPackageKey(ExportDirectory / PackagePath));
+			}
+
+			continue;
+		}
+
+		CollectReferencedPackages(Pair.Value, ExportDirectory, OutPackageKeys);
+	}
+}
+
+void FToolImportFolder::Execute() {
+	UJsonAsAssetSettings* Settings = GetSettings();
+
+	/* Conditional Settings Checks */
+	if (!UJsonAsAssetSettings::EnsureExportDirectoryIsValid(Settings)) return;
+	if (!CloudModule::VerifyActivity(Settings)) return;
+	CloudModule::RetrieveMetadata();
+
+	const FString Folder = OpenFolderDialog("Select a folder of JSON files", Settings->ExportDirectory.Path);
+	if (Folder.IsEmpty()) {
+		return;
+	}
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFilesRecursive(Files, *Folder, TEXT("*.json"), true, false);
+
+	if (Files.Num() == 0) {
+		SpawnPrompt("No JSON files found", "The selected folder does not contain any JSON files.");
+		return;
+	}
+
+	EmptyMessageLog();
+	ImportFiles(Files);
+}
+
+void FToolImportFolder::ImportFiles(const TArray<FString>& Files) {
+	const UJsonAsAssetSettings* Settings = GetSettings();
+	const FString ExportDirectory = Settings->ExportDirectory.Path;
+
+	FScopedSlowTask SlowTask(Files.Num() * 2, FText::FromString("Importing JSON files"));
+	SlowTask.MakeDialog(true);
+
+	/* Files are parsed independently of each other, only the import itself has to run on the game thread */
+	TArray<TArray<TSharedPtr<FJsonValue>>> ParsedFiles;
+	TArray<TSet<FString>> ReferencedPackages;
+	TArray<bool> ParseResults;
+	ParsedFiles.SetNum(Files.Num());
+	ReferencedPackages.SetNum(Files.Num());
+	ParseResults.SetNumZeroed(Files.Num());
+
+	ParallelFor(Files.Num(), [&](const int32 FileIndex) {
+		ParseResults[FileIndex] = DeserializeJSON(Files[FileIndex], ParsedFiles[FileIndex]);
+
+		for (const TSharedPtr<FJsonValue>& Export : ParsedFiles[FileIndex]) {
+			CollectReferencedPackages(Export, ExportDirectory, ReferencedPackages[FileIndex]);
+		}
+	});
+	SlowTask.EnterProgressFrame(Files.Num());
+
+	TMap<FString, int32> FileIndicesByPackage;
+	FileIndicesByPackage.Reserve(Files.Num());
+
+	for (int32 FileIndex = 0; FileIndex < Files.Num(); FileIndex++) {
+		FileIndicesByPackage.Add(GetPackageKey(Files[FileIndex]), FileIndex);
+	}
+
+	/* Order the files so referenced assets are imported first. References forming a cycle are imported in the order they were found */
+	TArray<int32> ImportOrder;
+	ImportOrder.Reserve(Files.Num());
+
+	enum class EVisitState : uint8 { Unvisited, Visiting, Visited };
+	TArray<EVisitState> VisitStates;
+	VisitStates.Init(EVisitState::Unvisited, Files.Num());
+
+	for (int32 RootIndex = 0; RootIndex < Files.Num(); RootIndex++) {
+		if (VisitStates[RootIndex] != EVisitState::Unvisited) continue;
+
+		/* Depth first search with an explicit stack, long reference chains would overflow the call stack */
+		TArray<TPair<int32, TArray<int32>>> Stack;
+		VisitStates[RootIndex] = EVisitState::Visiting;
+		Stack.Emplace(RootIndex, TArray<int32>());
+
+		for (const FString& PackageKey : ReferencedPackages[RootIndex]) {
+			if (const int32* DependencyIndex = FileIndicesByPackage.Find(PackageKey)) {
+				Stack.Last().Value.Add(*DependencyIndex);
+			}
+		}
+
+		while (Stack.Num() > 0) {
+			TArray<int32>& Dependencies = Stack.Last().Value;
+
+			if (Dependencies.Num() == 0) {
+				const int32 FileIndex = Stack.Last().Key;
+
+				VisitStates[FileIndex] = EVisitState::Visited;
+				ImportOrder.Add(FileIndex);
+				Stack.Pop();
+
+				continue;
+			}
+
+			const int32 DependencyIndex = Dependencies.Pop();
+			if (VisitStates[DependencyIndex] != EVisitState::Unvisited) continue;
+
+			VisitStates[DependencyIndex] = EVisitState::Visiting;
+			TArray<int32> DependencyDependencies;
+
+			for (const FString& PackageKey : ReferencedPackages[DependencyIndex]) {
+				if (const int32* Index = FileIndicesByPackage.Find(PackageKey)) {
+					DependencyDependencies.Add(*Index);
+				}
+			}
+
+			Stack.Emplace(DependencyIndex, MoveTemp(DependencyDependencies));
+		}
+	}
+
+	/* Assets are announced to the asset registry and saved once the batch goes out of scope */
+	FImportBatch Batch;
+	int32 NumUnreadable = 0;
+
+	/* Time spent in the importers and the serializers, excluding parsing and saving, so builds of the serializers can be compared */
+	double ImportSeconds = 0.0;
+
+	for (const int32 FileIndex : ImportOrder) {
+		SlowTask.EnterProgressFrame(1, FText::FromString(FPaths::GetBaseFilename(Files[FileIndex])));
+
+		if (SlowTask.ShouldCancel()) break;
+
+		if (!ParseResults[FileIndex]) {
+			NumUnreadable++;
+			GetMessageLog().Error(FText::FromString("Failed to parse JSON file: " + Files[FileIndex]));
+
+			continue;
+		}
+
+		const double ImportStartTime = FPlatformTime::Seconds();
+		IImporter::ReadExportsAndImport(ParsedFiles[FileIndex], Files[FileIndex]);
+		ImportSeconds += FPlatformTime::Seconds() - ImportStartTime;
+
+		/* The parsed file is no longer needed once its assets exist */
+		ParsedFiles[FileIndex].Empty();
+	}
+
+	const double SaveStartTime = FPlatformTime::Seconds();
+	Batch.Finish();
+	const double SaveSeconds = FPlatformTime::Seconds() - SaveStartTime;
+
+	UE_LOG(LogJsonAsAsset, Log, TEXT("Imported %d assets from %d files, %d failed, %d files could not be parsed"), Batch.GetNumImported(), Files.Num(), Batch.GetNumFailed(), NumUnreadable);
+	UE_LOG(LogJsonAsAsset, Log, TEXT("Importing took %.3f seconds, saving took %.3f seconds"), ImportSeconds, SaveSeconds);
+
+	const bool bAnyFailed = Batch.GetNumFailed() > 0 || NumUnreadable > 0;
+
+	AppendNotification(
+		FText::FromString(FString::Printf(TEXT("Imported %d assets"), Batch.GetNumImported())),
+		FText::FromString(FString::Printf(TEXT("%d files, %d failed"), Files.Num(), Batch.GetNumFailed() + NumUnreadable)),
+		4.0f,
+		bAnyFailed ? SNotificationItem::CS_Fail : SNotificationItem::CS_Success,
+		false,
+		350.0f
+	);
+
+	if (bAnyFailed) {
+		OpenMessageLog();
+	}
+}
@@ -9,6 +9,7 @@
 #include "Modules/Tools/AnimationData.h"
 #include "Modules/Tools/ClearImportData.h"
 #include "Modules/Tools/ConvexCollision.h"
+#include "Modules/Tools/ImportFolder.h"
 #include "Modules/Tools/SkeletalMeshData.h"
 
 void IToolsDropdownBuilder::Build(FMenuBuilder& MenuBuilder) const {
@@ -24,6 +25,17 @@ void IToolsDropdownBuilder::Build(FMenuBuilder& MenuBuilder) const {
 		FNewMenuDelegate::CreateLambda([this, Settings](FMenuBuilder& InnerMenuBuilder) {
 			InnerMenuBuilder.BeginSection("JsonAsAssetToolsSection", FText::FromString("Tools"));
 			{
+				InnerMenuBuilder.AddMenuEntry(
+					FText::FromString("Import Folder"),
+					FText::FromString("Imports every JSON file in a folder and its sub-folders, creating referenced assets first and saving them all at the end."),
+					FSlateIcon(FAppStyle::GetAppStyleSetName(), "LevelEditor.BspMode"),
+
+					FUIAction(
+						FExecuteAction::CreateStatic(&FToolImportFolder::Execute)
+					),
+					NAME_None
+				);
+
 				InnerMenuBuilder.AddMenuEntry(
 					FText::FromString("Clear Import Data"),
 					FText::FromString(""),
@@ -3,6 +3,7 @@
 #include "Utilities/AssetUtilities.h"
 
 #include "Importers/Constructor/Importer.h"
+#include "Importers/Constructor/ImportBatch.h"
 
 #include "Utilities/Textures/TextureCreatorUtilities.h"
 
@@ -116,6 +117,23 @@ UPackage* FAssetUtilities::CreateAssetPackage(const FString& Name, const FString
 	return Package;
 }
 
+void FAssetUtilities::SavePackage(UPackage* Package) {
+	const FString PackageName = Package->GetName();
+	const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+
+#if ENGINE_UE5
+	FSavePackageArgs SaveArgs; {
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.Error = GError;
+		SaveArgs.SaveFlags = SAVE_NoError;
+	}
+	
+	UPackage::SavePackage(Package, nullptr, *PackageFileName, SaveArgs);
+#else
+	UPackage::SavePackage(Package, nullptr, RF_Standalone, *PackageFileName);
+#endif
+}
+
 UPackage* FAssetUtilities::CreateAssetPackage(const FString& Name, const FString& OutputPath) {
 	UPackage* Ignore = nullptr; /* Put here because &nullptr doesn't work */
 	FString StringIgnore = "";
@@ -295,7 +313,15 @@ bool FAssetUtilities::Construct_TypeTexture(const FString& Path, const FString&
 		return false;
 	}
 
-	FAssetRegistryModule::AssetCreated(Texture);
+	/* Imports of a batch announce their assets once the batch is finished */
+	FImportBatch* Batch = FImportBatch::Get();
+
+	if (Batch) {
+		Batch->AddCreatedAsset(Texture);
+	} else {
+		FAssetRegistryModule::AssetCreated(Texture);
+	}
+
 	if (!Texture->MarkPackageDirty()) {
 		return false;
 	}
@@ -307,18 +333,11 @@ bool FAssetUtilities::Construct_TypeTexture(const FString& Path, const FString&
 
 	/* Save texture */
 	if (Settings->AssetSettings.bSavePackagesOnImport) {
-		const FString PackageName = Package->GetName();
-		const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
-#if ENGINE_UE5
-		FSavePackageArgs SaveArgs; {
-			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-			SaveArgs.SaveFlags = SAVE_NoError;
+		if (Batch) {
+			Batch->AddPackageToSave(Package);
+		} else {
+			SavePackage(Package);
 		}
-		
-		UPackage::SavePackage(Package, nullptr, *PackageFileName, SaveArgs);
-#else
-		UPackage::SavePackage(Package, nullptr, RF_Standalone, *PackageFileName);
-#endif
 	}
 
 	OutTexture = Texture;
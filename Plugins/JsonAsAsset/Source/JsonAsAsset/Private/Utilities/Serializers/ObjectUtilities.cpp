@@ -15,7 +15,7 @@
 
 /* ReSharper disable once CppDeclaratorNeverUsed */
 DECLARE_LOG_CATEGORY_CLASS(LogJsonAsAssetObjectSerializer, All, All);
-PRAGMA_DISABLE_OPTIMIZATION
+JSONASASSET_DISABLE_SERIALIZER_OPTIMIZATION
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
@@ -74,7 +74,7 @@ void UObjectSerializer::DeserializeExports(TArray<TSharedPtr<FJsonValue>> InExpo
 		FString Outer = ExportObject->GetStringField(TEXT("Outer"));
 		
 		/* Add it to the referenced objects */
-		PropertySerializer->ExportsContainer.Exports.Add(FUObjectExport(FName(*Name), FName(*Type), FName(*Outer), ExportObject, nullptr, Parent, Index));
+		PropertySerializer->ExportsContainer.Add(FUObjectExport(FName(*Name), FName(*Type), FName(*Outer), ExportObject, nullptr, Parent, Index));
 	}
 
 	for (FUObjectExport& Export : PropertySerializer->ExportsContainer.Exports) {
@@ -131,7 +131,8 @@ void UObjectSerializer::DeserializeExport(FUObjectExport& Export, TMap<TSharedPt
 	UObject* ObjectOuter = nullptr;
 
 	if (FUObjectExport& FoundExport = PropertySerializer->ExportsContainer.Find(Outer); FoundExport.JsonObject.IsValid()) {
-		if (FoundExport.Object == nullptr) {
+		/* An export naming itself as its outer would recurse until the stack overflows */
+		if (FoundExport.Object == nullptr && &FoundExport != &Export) {
 			DeserializeExport(FoundExport, ExportsMap);
 		}
 		
@@ -247,4 +248,4 @@ void UObjectSerializer::DeserializeObjectProperties(const TSharedPtr<FJsonObject
 	}
 }
 
-PRAGMA_ENABLE_OPTIMIZATION
\ No newline at end of file
+JSONASASSET_ENABLE_SERIALIZER_OPTIMIZATION
\ No newline at end of file
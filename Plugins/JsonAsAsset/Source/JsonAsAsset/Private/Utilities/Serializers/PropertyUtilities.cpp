@@ -13,7 +13,7 @@
 #include "Utilities/Serializers/Structs/TimespanSerializer.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogJsonAsAssetPropertySerializer, Error, Log);
-PRAGMA_DISABLE_OPTIMIZATION
+JSONASASSET_DISABLE_SERIALIZER_OPTIMIZATION
 
 UPropertySerializer::UPropertySerializer() {
 	this->FallbackStructSerializer = MakeShared<FFallbackStructSerializer>(this);
@@ -144,10 +144,10 @@ void UPropertySerializer::DeserializePropertyValue(FProperty* Property, const TS
 
 			if (bUseDefaultLoadObject) {
 				/* Use IImporter to import the object */
-				IImporter* Importer = new IImporter();
+				IImporter Importer;
 
-				Importer->ParentObject = ObjectSerializer->Parent;
-				Importer->LoadObject(&JsonValueAsObject, Object);
+				Importer.ParentObject = ObjectSerializer->Parent;
+				Importer.LoadObject(&JsonValueAsObject, Object);
 
 				if (Object == nullptr) {
 					if (ObjectProperty && ObjectProperty->PropertyClass) {
@@ -198,7 +198,7 @@ void UPropertySerializer::DeserializePropertyValue(FProperty* Property, const TS
 				ObjectName.Split("'", &ObjectName, nullptr);
 			}
 
-			if (FUObjectExport Export = ExportsContainer.Find(ObjectName); Export.Object != nullptr) {
+			if (const FUObjectExport& Export = ExportsContainer.Find(ObjectName); Export.Object != nullptr) {
 				UObject* FoundObject = Export.Object;
 
 				if (FoundObject) {
@@ -222,7 +222,7 @@ void UPropertySerializer::DeserializePropertyValue(FProperty* Property, const TS
 					ObjectOuter.Split(":", nullptr, &ObjectOuter);
 				}
 				
-				if (FUObjectExport Export = ExportsContainer.Find(ObjectName, ObjectOuter); Export.Object != nullptr) {
+				if (const FUObjectExport& Export = ExportsContainer.Find(ObjectName, ObjectOuter); Export.Object != nullptr) {
 					UObject* FoundObject = Export.Object;
 
 					if (FoundObject) {
@@ -235,7 +235,7 @@ void UPropertySerializer::DeserializePropertyValue(FProperty* Property, const TS
 				if (UObject* Parent = ObjectSerializer->Parent) {
 					FString Name = Parent->GetName();
 
-					if (FUObjectExport Export = ExportsContainer.Find(ObjectName, Name); Export.Object != nullptr) {
+					if (const FUObjectExport& Export = ExportsContainer.Find(ObjectName, Name); Export.Object != nullptr) {
 						UObject* FoundObject = Export.Object;
 
 						if (FoundObject) {
@@ -278,10 +278,11 @@ void UPropertySerializer::DeserializePropertyValue(FProperty* Property, const TS
 			PathString = SoftJsonObjectProperty->GetStringField(TEXT("AssetPathName"));
 			
 			if (PathString != "") {
-				FSoftObjectPtr* ObjectPtr = static_cast<FSoftObjectPtr*>(OutValue);
-				*ObjectPtr = FSoftObjectPath(PathString);
+				/* The value is a plain FSoftObjectPath, it has no room for the weak pointer of an FSoftObjectPtr */
+				FSoftObjectPath* ObjectPath = static_cast<FSoftObjectPath*>(OutValue);
+				*ObjectPath = FSoftObjectPath(PathString);
 
-				if (!ObjectPtr->LoadSynchronous()) {
+				if (!ObjectPath->TryLoad()) {
 					/* Try importing it using Cloud */
 					FString PackagePath;
 					FString AssetName;
@@ -435,7 +436,7 @@ bool UPropertySerializer::ShouldDeserializeProperty(FProperty* Property) const {
 		return false;
 	}
 	/* Skip blacklisted properties */
-	if (this != nullptr && this && BlacklistedProperties.IsValidIndex(0) && BlacklistedProperties.Contains(Property)) {
+	if (BlacklistedProperties.Contains(Property)) {
 		return false;
 	}
 	return true;
@@ -452,4 +453,4 @@ FStructSerializer* UPropertySerializer::GetStructSerializer(const UScriptStruct*
 	return StructSerializer && ensure(StructSerializer->IsValid()) ? StructSerializer->Get() : FallbackStructSerializer.Get();
 }
 
-PRAGMA_ENABLE_OPTIMIZATION
\ No newline at end of file
+JSONASASSET_ENABLE_SERIALIZER_OPTIMIZATION
\ No newline at end of file
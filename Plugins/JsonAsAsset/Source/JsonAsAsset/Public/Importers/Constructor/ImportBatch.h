@@ -0,0 +1,42 @@
+/* Copyright JsonAsAsset Contributors 2024-2025 */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Defers the side effects of importing an asset while many assets are imported at once.
+ * While a batch is active, created assets are only announced to the asset registry and
+ * the content browser once the batch finishes, and their packages are saved in one pass.
+ */
+class JSONASASSET_API FImportBatch {
+public:
+	FImportBatch();
+	~FImportBatch();
+
+	UE_NONCOPYABLE(FImportBatch);
+
+	/* The batch of the imports in progress, null when assets are imported one at a time */
+	static FImportBatch* Get();
+
+	void AddCreatedAsset(UObject* Asset);
+	void AddPackageToSave(UPackage* Package);
+	void AddResult(bool bSuccessful);
+
+	/* Notifies the asset registry of every created asset, syncs the content browser to them and saves their packages */
+	void Finish();
+
+	int32 GetNumImported() const { return NumImported; }
+	int32 GetNumFailed() const { return NumFailed; }
+
+private:
+	TArray<TWeakObjectPtr<UObject>> CreatedAssets;
+	TArray<TWeakObjectPtr<UPackage>> PackagesToSave;
+	TSet<UPackage*> QueuedPackages;
+
+	int32 NumImported = 0;
+	int32 NumFailed = 0;
+
+	FImportBatch* PreviousBatch;
+	static FImportBatch* ActiveBatch;
+};
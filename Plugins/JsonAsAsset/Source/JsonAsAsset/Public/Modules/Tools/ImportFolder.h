@@ -0,0 +1,17 @@
+/* Copyright JsonAsAsset Contributors 2024-2025 */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ToolBase.h"
+
+/* Imports every JSON export in a folder and its sub-folders as one batch */
+struct FToolImportFolder : FToolBase {
+	static void Execute();
+
+	/*
+	 * Parses the files in parallel, then imports them so that assets are created
+	 * before the assets referencing them. Assets are announced and saved once at the end.
+	 */
+	static void ImportFiles(const TArray<FString>& Files);
+};
@@ -12,6 +12,9 @@ public:
 	static UPackage* CreateAssetPackage(const FString& FullPath);
 	static UPackage* CreateAssetPackage(const FString& Name, const FString& OutputPath);
 	static UPackage* CreateAssetPackage(const FString& Name, const FString& OutputPath, UPackage*& OutOutermostPkg, FString& FailureReason);
+
+	/* Writes the package of an imported asset to disk */
+	static void SavePackage(UPackage* Package);
 	
 public:
 	/* Importing assets from Cloud */
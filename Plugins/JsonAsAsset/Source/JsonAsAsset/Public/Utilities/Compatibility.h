@@ -12,6 +12,11 @@
 #define JSONASASSET_EXPERIMENTAL 0
 #endif
 
+/* Compiles the property and object serializers without optimization, to step through them in a debugger */
+#ifndef JSONASASSET_DEBUG_SERIALIZERS
+#define JSONASASSET_DEBUG_SERIALIZERS 0
+#endif
+
 #if ENGINE_MAJOR_VERSION == 5
 	#define ENGINE_UE5 1
 #else
@@ -90,6 +95,17 @@
 	#define UE5_1_BELOW 0
 #endif
 
+#if !JSONASASSET_DEBUG_SERIALIZERS
+	#define JSONASASSET_DISABLE_SERIALIZER_OPTIMIZATION
+	#define JSONASASSET_ENABLE_SERIALIZER_OPTIMIZATION
+#elif UE5_2_BEYOND
+	#define JSONASASSET_DISABLE_SERIALIZER_OPTIMIZATION UE_DISABLE_OPTIMIZATION
+	#define JSONASASSET_ENABLE_SERIALIZER_OPTIMIZATION UE_ENABLE_OPTIMIZATION
+#else
+	#define JSONASASSET_DISABLE_SERIALIZER_OPTIMIZATION PRAGMA_DISABLE_OPTIMIZATION
+	#define JSONASASSET_ENABLE_SERIALIZER_OPTIMIZATION PRAGMA_ENABLE_OPTIMIZATION
+#endif
+
 #if UE4_26_0
 #include "AssetRegistry/Public/AssetRegistryModule.h"
 #endif
@@ -53,16 +53,27 @@ struct FUObjectExport {
 };
 
 struct FUObjectExportContainer {
-	/* Array of Expression Exports */
+	/* Array of Expression Exports, only append to it through Add so the lookup indices stay valid */
 	TArray<FUObjectExport> Exports;
 	
 	FUObjectExportContainer() {};
 
+	/* Appends an export and indexes it, earlier exports take precedence in lookups like they did when exports were searched in order */
+	FUObjectExport& Add(const FUObjectExport& Export) {
+		const int32 Index = Exports.Add(Export);
+
+		NameIndex.FindOrAdd(Export.Name, Index);
+		NameOuterIndex.FindOrAdd(TPair<FName, FName>(Export.Name, Export.Outer), Index);
+		PositionIndex.FindOrAdd(Export.Position, Index);
+		TypeIndex.FindOrAdd(Export.Type, Index);
+		TypeOuterIndex.FindOrAdd(TPair<FName, FName>(Export.Type, Export.Outer), Index);
+
+		return Exports[Index];
+	}
+
 	FUObjectExport& Find(const FName Name) {
-		for (FUObjectExport& Export : Exports) {
-			if (Export.Name == Name) {
-				return Export;
-			}
+		if (const int32* Index = NameIndex.Find(Name)) {
+			return Exports[*Index];
 		}
 
 		static FUObjectExport Dummy;
@@ -71,96 +82,81 @@ struct FUObjectExportContainer {
 
 	template<typename T>
 	T* Find(const FName Name) const {
-		for (FUObjectExport Export : Exports) {
-			if (Export.Name == Name) {
-				return Export.Get<T>();
-			}
+		if (const int32* Index = NameIndex.Find(Name)) {
+			return Exports[*Index].Get<T>();
 		}
 
 		return nullptr;
 	}
 
-	FUObjectExport Find(const FName Name, const FName Outer) {
-		for (FUObjectExport Export : Exports) {
-			if (Export.Name == Name && Export.Outer == Outer) {
-				return Export;
-			}
-		}
-
-		return FUObjectExport();
+	const FUObjectExport& Find(const FName Name, const FName Outer) const {
+		return FindInIndex(NameOuterIndex, TPair<FName, FName>(Name, Outer));
 	}
 
-	FUObjectExport Find(const int Position) {
-		for (FUObjectExport Export : Exports) {
-			if (Export.Position == Position) {
-				return Export;
-			}
-		}
-
-		return FUObjectExport();
+	const FUObjectExport& Find(const int Position) const {
+		return FindInIndex(PositionIndex, Position);
 	}
 
-	UObject* FindRef(const int Position) {
-		for (const FUObjectExport Export : Exports) {
-			if (Export.Position == Position) {
-				return Export.Object;
-			}
-		}
-
-		return nullptr;
+	UObject* FindRef(const int Position) const {
+		return Find(Position).Object;
 	}
 
 	FUObjectExport& Find(const FString& Name) {
 		return Find(FName(*Name));
 	}
 
-	FUObjectExport Find(const FString& Name, const FString& Outer) {
+	const FUObjectExport& Find(const FString& Name, const FString& Outer) const {
 		return Find(FName(*Name), FName(*Outer));
 	}
 
-	FUObjectExport FindByType(const FName Type) {
-		for (FUObjectExport Export : Exports) {
-			if (Export.Type == Type) {
-				return Export;
-			}
-		}
-
-		return FUObjectExport();
+	const FUObjectExport& FindByType(const FName Type) const {
+		return FindInIndex(TypeIndex, Type);
 	}
 
-	FUObjectExport FindByType(const FString& Type) {
+	const FUObjectExport& FindByType(const FString& Type) const {
 		return FindByType(FName(*Type));
 	}
 
-	FUObjectExport FindByType(const FName Type, const FName Outer) {
-		for (FUObjectExport Export : Exports) {
-			if (Export.Type == Type && Export.Outer == Outer) {
-				return Export;
-			}
-		}
-
-		return FUObjectExport();
+	const FUObjectExport& FindByType(const FName Type, const FName Outer) const {
+		return FindInIndex(TypeOuterIndex, TPair<FName, FName>(Type, Outer));
 	}
 
-	FUObjectExport FindByType(const FString& Type, const FString& Outer) {
+	const FUObjectExport& FindByType(const FString& Type, const FString& Outer) const {
 		return FindByType(FName(*Type), FName(*Outer));
 	}
 	
-	bool Contains(const FName Name) {
-		for (FUObjectExport Export : Exports) {
-			if (Export.Name == Name) {
-				return true;
-			}
-		}
-
-		return false;
+	bool Contains(const FName Name) const {
+		return NameIndex.Contains(Name);
 	}
 
 	void Empty() {
 		Exports.Empty();
+		NameIndex.Empty();
+		NameOuterIndex.Empty();
+		PositionIndex.Empty();
+		TypeIndex.Empty();
+		TypeOuterIndex.Empty();
 	}
 	
 	int Num() const {
 		return Exports.Num();
 	}
+
+private:
+	/* Indices of the first export with a given key, so references can be resolved without scanning every export */
+	TMap<FName, int32> NameIndex;
+	TMap<TPair<FName, FName>, int32> NameOuterIndex;
+	TMap<int, int32> PositionIndex;
+	TMap<FName, int32> TypeIndex;
+	TMap<TPair<FName, FName>, int32> TypeOuterIndex;
+
+	template<typename KeyType>
+	const FUObjectExport& FindInIndex(const TMap<KeyType, int32>& Index, const KeyType& Key) const {
+		if (const int32* ExportIndex = Index.Find(Key)) {
+			return Exports[*ExportIndex];
+		}
+
+		static const FUObjectExport NotFound;
+		return NotFound;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,321 @@
+#include "SuziePlugin.h"
+#include "SuzieFlagNameTable.h"
+#include "SuzieGenerationStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/** Micro-benchmarks for the class generation internals. Run them from the editor console and compare the logged numbers between builds */
+class FSuzieBenchmarks
+{
+public:
+	/** Compares the flag name table against set-based flag parsing used previously, per property flags string */
+	static void BenchmarkParseFlags(const TArray<FString>& Args)
+	{
+		FSuzieGenerationStats::WarnIfUnoptimized(TEXT("ParseFlags benchmark"));
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100000;
+
+		// Typical flag strings of dumped properties, from plain data members to function parameters
+		const TArray<FString> SampleFlags = {
+			TEXT("CPF_Edit | CPF_BlueprintVisible | CPF_ZeroConstructor | CPF_IsPlainOldData | CPF_NoDestructor | CPF_HasGetValueTypeHash | CPF_NativeAccessSpecifierPublic"),
+			TEXT("CPF_Edit | CPF_ExportObject | CPF_ZeroConstructor | CPF_InstancedReference | CPF_NoDestructor | CPF_PersistentInstance | CPF_HasGetValueTypeHash | CPF_NativeAccessSpecifierPrivate"),
+			TEXT("CPF_Parm | CPF_OutParm | CPF_ReferenceParm | CPF_NativeAccessSpecifierPublic"),
+			TEXT("CPF_Parm | CPF_OutParm | CPF_ZeroConstructor | CPF_ReturnParm | CPF_IsPlainOldData | CPF_NoDestructor | CPF_HasGetValueTypeHash | CPF_NativeAccessSpecifierPublic"),
+			TEXT("CPF_Net | CPF_ZeroConstructor | CPF_Transient | CPF_IsPlainOldData | CPF_RepNotify | CPF_NoDestructor | CPF_Protected | CPF_HasGetValueTypeHash | CPF_NativeAccessSpecifierProtected"),
+			TEXT("CPF_None"),
+		};
+		const TSuzieFlagNameTable<EPropertyFlags>& FlagNameTable = FSuziePluginModule::GetPropertyFlagNameTable();
+
+		// Both implementations have to agree before their timings mean anything
+		for (const FString& Flags : SampleFlags)
+		{
+			checkf(ParsePropertyFlagsReference(FlagNameTable, Flags) == FSuziePluginModule::ParsePropertyFlags(Flags), TEXT("Flag parsing mismatch for %s"), *Flags);
+		}
+
+		// Accumulate the results so that the compiler cannot discard the work
+		uint64 Checksum = 0;
+		const double ReferenceStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (const FString& Flags : SampleFlags)
+			{
+				Checksum += (uint64)ParsePropertyFlagsReference(FlagNameTable, Flags);
+			}
+		}
+		const double ReferenceTime = FPlatformTime::Seconds() - ReferenceStartTime;
+
+		const double TableStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (const FString& Flags : SampleFlags)
+			{
+				Checksum -= (uint64)FSuziePluginModule::ParsePropertyFlags(Flags);
+			}
+		}
+		const double TableTime = FPlatformTime::Seconds() - TableStartTime;
+
+		const double NumParsedStrings = (double)Iterations * SampleFlags.Num();
+		UE_LOG(LogSuzie, Display, TEXT("ParseFlags benchmark (%d iterations, checksum %llu): set-based %.1f ns/property, flag name table %.1f ns/property (%.2fx)"),
+			Iterations, Checksum, ReferenceTime * 1e9 / NumParsedStrings, TableTime * 1e9 / NumParsedStrings, ReferenceTime / FMath::Max(TableTime, UE_DOUBLE_SMALL_NUMBER));
+	}
+
+	/** Constructs instances of the given dynamic class and reports how many of them can be created per second. Actors are spawned into the current world */
+	static void BenchmarkSpawn(const TArray<FString>& Args, UWorld* World)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogSuzie, Display, TEXT("Usage: Suzie.Benchmark.Spawn <ClassPath> [Count]"));
+			return;
+		}
+		UClass* Class = FindObject<UClass>(nullptr, *Args[0]);
+		if (Class == nullptr || Class->HasAnyClassFlags(CLASS_Abstract))
+		{
+			UE_LOG(LogSuzie, Warning, TEXT("Class %s does not exist or is abstract"), *Args[0]);
+			return;
+		}
+		FSuzieGenerationStats::WarnIfUnoptimized(TEXT("Spawn benchmark"));
+		const bool bIsActorClass = Class->IsChildOf<AActor>();
+		if (bIsActorClass && World == nullptr)
+		{
+			UE_LOG(LogSuzie, Warning, TEXT("Spawning actors of class %s requires a world"), *Args[0]);
+			return;
+		}
+		const int32 Count = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 1000;
+
+		TArray<UObject*> Instances;
+		Instances.Reserve(Count);
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Count; Index++)
+		{
+			if (bIsActorClass)
+			{
+				FActorSpawnParameters SpawnParameters;
+				SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+				SpawnParameters.ObjectFlags = RF_Transient;
+				Instances.Add(World->SpawnActor(Class, &FTransform::Identity, SpawnParameters));
+			}
+			else
+			{
+				Instances.Add(NewObject<UObject>(GetTransientPackage(), Class, NAME_None, RF_Transient));
+			}
+		}
+		const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+		// Tear down the instances outside of the measured time, they will be collected on the next garbage collection
+		for (UObject* Instance : Instances)
+		{
+			if (AActor* Actor = Cast<AActor>(Instance))
+			{
+				Actor->Destroy();
+			}
+			else if (Instance)
+			{
+				Instance->MarkAsGarbage();
+			}
+		}
+
+		UE_LOG(LogSuzie, Display, TEXT("Spawn benchmark for %s: %d instances in %.2f ms, %.0f instances/s, %.2f us/instance"),
+			*Class->GetPathName(), Count, ElapsedTime * 1000.0, Count / FMath::Max(ElapsedTime, UE_DOUBLE_SMALL_NUMBER), ElapsedTime * 1e6 / Count);
+	}
+
+	/** Measures the per-element cost of decoding large arrays, sets and maps of numbers, names, structs and object references, with and without the bulk container paths */
+	static void BenchmarkContainers(const TArray<FString>& Args)
+	{
+		FSuzieGenerationStats::WarnIfUnoptimized(TEXT("Containers benchmark"));
+		const int32 NumElements = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+		const int32 Iterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 20;
+		IConsoleVariable* BulkContainerDeserializationVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("Suzie.BulkContainerDeserialization"));
+		FSuziePluginModule& SuziePluginModule = FModuleManager::LoadModuleChecked<FSuziePluginModule>(TEXT("Suzie"));
+
+		// Object references have to point to objects that exist, so cycle through a few native classes
+		const TCHAR* const ObjectPaths[] = {TEXT("/Script/CoreUObject.Object"), TEXT("/Script/Engine.Actor"), TEXT("/Script/Engine.SceneComponent")};
+		const auto MakeNumber = [](const int32 Index) { return MakeShared<FJsonValueNumber>(Index); };
+		const auto MakeFloat = [](const int32 Index) { return MakeShared<FJsonValueNumber>(Index * 0.5); };
+		const auto MakeName = [](const int32 Index) { return MakeShared<FJsonValueString>(FString::Printf(TEXT("Name_%d"), Index)); };
+		const auto MakeObject = [&ObjectPaths](const int32 Index) { return MakeShared<FJsonValueString>(ObjectPaths[Index % UE_ARRAY_COUNT(ObjectPaths)]); };
+		const auto MakeVector = [](const int32 Index)
+		{
+			const TSharedRef<FJsonObject> Vector = MakeShared<FJsonObject>();
+			Vector->SetNumberField(TEXT("X"), Index);
+			Vector->SetNumberField(TEXT("Y"), Index * 2.0);
+			Vector->SetNumberField(TEXT("Z"), Index * 3.0);
+			return MakeShared<FJsonValueObject>(Vector);
+		};
+		const auto MakeElements = [NumElements](const TFunctionRef<TSharedRef<FJsonValue>(int32)> MakeElement)
+		{
+			TArray<TSharedPtr<FJsonValue>> Elements;
+			Elements.Reserve(NumElements);
+			for (int32 ElementIndex = 0; ElementIndex < NumElements; ElementIndex++)
+			{
+				Elements.Add(MakeElement(ElementIndex));
+			}
+			return MakeShared<FJsonValueArray>(Elements);
+		};
+		const auto MakePairs = [NumElements](const TFunctionRef<TSharedRef<FJsonValue>(int32)> MakeValue)
+		{
+			TArray<TSharedPtr<FJsonValue>> Pairs;
+			Pairs.Reserve(NumElements);
+			for (int32 PairIndex = 0; PairIndex < NumElements; PairIndex++)
+			{
+				Pairs.Add(MakeShared<FJsonValueArray>(TArray<TSharedPtr<FJsonValue>>{MakeShared<FJsonValueNumber>(PairIndex), MakeValue(PairIndex)}));
+			}
+			return MakeShared<FJsonValueArray>(Pairs);
+		};
+
+		struct FContainerCase
+		{
+			TSharedRef<FJsonObject> PropertyDescriptor;
+			TSharedRef<FJsonValue> Value;
+		};
+		const TArray<FContainerCase> Cases = {
+			{MakeContainerDescriptor(TEXT("IntArray"), TEXT("ArrayProperty"), TEXT("inner"), MakePropertyDescriptor(TEXT("IntProperty"))), MakeElements(MakeNumber)},
+			{MakeContainerDescriptor(TEXT("FloatArray"), TEXT("ArrayProperty"), TEXT("inner"), MakePropertyDescriptor(TEXT("FloatProperty"))), MakeElements(MakeFloat)},
+			{MakeContainerDescriptor(TEXT("VectorArray"), TEXT("ArrayProperty"), TEXT("inner"), MakeVectorDescriptor()), MakeElements(MakeVector)},
+			{MakeContainerDescriptor(TEXT("ObjectArray"), TEXT("ArrayProperty"), TEXT("inner"), MakeObjectDescriptor()), MakeElements(MakeObject)},
+			{MakeContainerDescriptor(TEXT("IntSet"), TEXT("SetProperty"), TEXT("key_prop"), MakePropertyDescriptor(TEXT("IntProperty"))), MakeElements(MakeNumber)},
+			{MakeContainerDescriptor(TEXT("NameSet"), TEXT("SetProperty"), TEXT("key_prop"), MakePropertyDescriptor(TEXT("NameProperty"))), MakeElements(MakeName)},
+			{MakeMapDescriptor(TEXT("IntFloatMap"), MakePropertyDescriptor(TEXT("FloatProperty"))), MakePairs(MakeFloat)},
+			{MakeMapDescriptor(TEXT("IntVectorMap"), MakeVectorDescriptor()), MakePairs(MakeVector)},
+			{MakeMapDescriptor(TEXT("IntObjectMap"), MakeObjectDescriptor()), MakePairs(MakeObject)},
+		};
+
+		// Container properties are built the same way as the properties of dumped structs, in a transient struct that is never registered
+		UScriptStruct* Struct = NewObject<UScriptStruct>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UScriptStruct::StaticClass(), TEXT("SuzieContainerBenchmark")), RF_Transient);
+		FDynamicClassGenerationContext Context;
+		TArray<TSharedPtr<FJsonValue>> PropertyDescriptors;
+		for (const FContainerCase& Case : Cases)
+		{
+			PropertyDescriptors.Add(MakeShared<FJsonValueObject>(Case.PropertyDescriptor));
+		}
+		const TArray<FProperty*> Properties = SuziePluginModule.AddPropertiesToStruct(Context, Struct, PropertyDescriptors);
+		check(Properties.Num() == Cases.Num());
+		Struct->Bind();
+		Struct->PrepareCppStructOps();
+		Struct->StaticLink(true);
+
+		// Results of the generic path are kept in a separate instance to verify that the bulk path decodes the same values
+		uint8* StructData = static_cast<uint8*>(FMemory::Malloc(Struct->GetStructureSize(), Struct->GetMinAlignment()));
+		uint8* ReferenceStructData = static_cast<uint8*>(FMemory::Malloc(Struct->GetStructureSize(), Struct->GetMinAlignment()));
+		Struct->InitializeStruct(StructData);
+		Struct->InitializeStruct(ReferenceStructData);
+
+		const bool bPreviousBulkContainerDeserialization = BulkContainerDeserializationVariable->GetBool();
+		UE_LOG(LogSuzie, Display, TEXT("Container deserialization benchmark (%d elements, %d iterations):"), NumElements, Iterations);
+		for (int32 CaseIndex = 0; CaseIndex < Cases.Num(); CaseIndex++)
+		{
+			const FProperty* Property = Properties[CaseIndex];
+			void* PropertyValuePtr = Property->ContainerPtrToValuePtr<void>(StructData);
+			const TSharedPtr<FJsonValue> Value = Cases[CaseIndex].Value;
+
+			double ElapsedTimes[2]{};
+			for (const bool bBulkContainerDeserialization : {false, true})
+			{
+				BulkContainerDeserializationVariable->Set(bBulkContainerDeserialization, ECVF_SetByCode);
+				for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+				{
+					// Sets and maps are merged into, so every iteration has to start from an empty container
+					Property->ClearValue(PropertyValuePtr);
+					const double StartTime = FPlatformTime::Seconds();
+					SuziePluginModule.DeserializePropertyValue(Property, PropertyValuePtr, Value);
+					ElapsedTimes[bBulkContainerDeserialization] += FPlatformTime::Seconds() - StartTime;
+				}
+				if (!bBulkContainerDeserialization)
+				{
+					Property->CopyCompleteValue_InContainer(ReferenceStructData, StructData);
+				}
+			}
+			checkf(Property->Identical_InContainer(ReferenceStructData, StructData), TEXT("Bulk and generic deserialization of %s produced different values"), *Property->GetName());
+
+			const double NumDecodedElements = (double)NumElements * Iterations;
+			UE_LOG(LogSuzie, Display, TEXT("  %-14s generic %7.1f ns/element, bulk %7.1f ns/element (%.2fx)"), *Property->GetName(),
+				ElapsedTimes[0] * 1e9 / NumDecodedElements, ElapsedTimes[1] * 1e9 / NumDecodedElements, ElapsedTimes[0] / FMath::Max(ElapsedTimes[1], UE_DOUBLE_SMALL_NUMBER));
+		}
+		BulkContainerDeserializationVariable->Set(bPreviousBulkContainerDeserialization, ECVF_SetByCode);
+
+		Struct->DestroyStruct(StructData);
+		Struct->DestroyStruct(ReferenceStructData);
+		FMemory::Free(StructData);
+		FMemory::Free(ReferenceStructData);
+		Struct->MarkAsGarbage();
+	}
+private:
+	/** Describes a property in the format of the dump */
+	static TSharedRef<FJsonObject> MakePropertyDescriptor(const TCHAR* Type, const TCHAR* Name = TEXT("Element"))
+	{
+		const TSharedRef<FJsonObject> PropertyDescriptor = MakeShared<FJsonObject>();
+		PropertyDescriptor->SetStringField(TEXT("name"), Name);
+		PropertyDescriptor->SetStringField(TEXT("type"), Type);
+		PropertyDescriptor->SetStringField(TEXT("flags"), TEXT("CPF_None"));
+		PropertyDescriptor->SetNumberField(TEXT("array_dim"), 1);
+		return PropertyDescriptor;
+	}
+
+	static TSharedRef<FJsonObject> MakeVectorDescriptor()
+	{
+		const TSharedRef<FJsonObject> PropertyDescriptor = MakePropertyDescriptor(TEXT("StructProperty"));
+		PropertyDescriptor->SetStringField(TEXT("struct"), TEXT("/Script/CoreUObject.Vector"));
+		return PropertyDescriptor;
+	}
+
+	static TSharedRef<FJsonObject> MakeObjectDescriptor()
+	{
+		const TSharedRef<FJsonObject> PropertyDescriptor = MakePropertyDescriptor(TEXT("ObjectProperty"));
+		PropertyDescriptor->SetStringField(TEXT("property_class"), TEXT("/Script/CoreUObject.Object"));
+		return PropertyDescriptor;
+	}
+
+	static TSharedRef<FJsonObject> MakeContainerDescriptor(const TCHAR* Name, const TCHAR* Type, const TCHAR* ElementFieldName, const TSharedRef<FJsonObject>& ElementDescriptor)
+	{
+		const TSharedRef<FJsonObject> PropertyDescriptor = MakePropertyDescriptor(Type, Name);
+		PropertyDescriptor->SetObjectField(ElementFieldName, ElementDescriptor);
+		return PropertyDescriptor;
+	}
+
+	/** Maps are keyed by integers, since not every value type can be hashed */
+	static TSharedRef<FJsonObject> MakeMapDescriptor(const TCHAR* Name, const TSharedRef<FJsonObject>& ValueDescriptor)
+	{
+		const TSharedRef<FJsonObject> PropertyDescriptor = MakeContainerDescriptor(Name, TEXT("MapProperty"), TEXT("key_prop"), MakePropertyDescriptor(TEXT("IntProperty"), TEXT("Key")));
+		PropertyDescriptor->SetObjectField(TEXT("value_prop"), ValueDescriptor);
+		return PropertyDescriptor;
+	}
+
+	/** Previous implementation: splits the string into a set of names, then probes the set for every known flag */
+	static EPropertyFlags ParsePropertyFlagsReference(const TSuzieFlagNameTable<EPropertyFlags>& FlagNameTable, const FString& Flags)
+	{
+		TArray<FString> FlagsArray;
+		Flags.ParseIntoArray(FlagsArray, TEXT(" | "), true);
+		TSet<FString> FlagNames;
+		for (const FString& Flag : FlagsArray)
+		{
+			FlagNames.Add(Flag);
+		}
+
+		EPropertyFlags PropertyFlags = CPF_None;
+		for (const auto& [FlagName, FlagBit] : FlagNameTable.GetEntries())
+		{
+			if (FlagNames.Contains(FlagName))
+			{
+				PropertyFlags |= FlagBit;
+			}
+		}
+		return PropertyFlags;
+	}
+};
+
+static FAutoConsoleCommand SuzieBenchmarkParseFlagsCommand(
+	TEXT("Suzie.Benchmark.ParseFlags"),
+	TEXT("Measures the per-property cost of converting dumped flag names to flag bits. Optional argument is the number of iterations."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FSuzieBenchmarks::BenchmarkParseFlags));
+
+static FAutoConsoleCommand SuzieBenchmarkContainersCommand(
+	TEXT("Suzie.Benchmark.Containers"),
+	TEXT("Measures the per-element cost of decoding arrays, sets and maps of property values, with and without the bulk container paths. Optional arguments are the number of elements and iterations."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FSuzieBenchmarks::BenchmarkContainers));
+
+static FAutoConsoleCommand SuzieBenchmarkSpawnCommand(
+	TEXT("Suzie.Benchmark.Spawn"),
+	TEXT("Measures how many instances of the given class can be constructed per second. Arguments are the class path and optionally the number of instances."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FSuzieBenchmarks::BenchmarkSpawn));
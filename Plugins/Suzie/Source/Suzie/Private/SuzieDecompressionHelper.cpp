@@ -4,7 +4,7 @@ THIRD_PARTY_INCLUDES_START
 #include "zlib.h"
 THIRD_PARTY_INCLUDES_END
 
-bool FSuzieDecompressionHelper::DecompressMemoryGzip(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData)
+bool FSuzieDecompressionHelper::DecompressMemoryGzip(const TConstArrayView<uint8> CompressedData, TArray<uint8>& OutDecompressedData)
 {
 	z_stream GzipStream;
 	GzipStream.zalloc = &FSuzieDecompressionHelper::ZlibAlloc;
@@ -17,32 +17,63 @@ bool FSuzieDecompressionHelper::DecompressMemoryGzip(const TArray<uint8>& Compre
 
 	// Init deflate settings to use GZIP
 	constexpr int32 GzipStreamEncoding = 16;
-	inflateInit2(&GzipStream, MAX_WBITS | GzipStreamEncoding);
+	if (inflateInit2(&GzipStream, MAX_WBITS | GzipStreamEncoding) != Z_OK)
+	{
+		return false;
+	}
 
-	uint8 LocalDecompressionBuffer[4096];
-	GzipStream.next_out = LocalDecompressionBuffer;
-	GzipStream.avail_out = sizeof(LocalDecompressionBuffer);
+	// Pre-size the output buffer so that a well-formed archive is inflated straight into its final location without any reallocations.
+	// If the size hint turns out to be wrong, grow the buffer in large chunks
+	constexpr int32 MinOutputGrowthSize = 4 * 1024 * 1024;
+	const int64 UncompressedSizeHint = GetGzipUncompressedSizeHint(CompressedData);
+	OutDecompressedData.Reset();
+	OutDecompressedData.SetNumUninitialized(UncompressedSizeHint > 0 && UncompressedSizeHint < MAX_int32 ? (int32)UncompressedSizeHint + 1 : MinOutputGrowthSize);
 
 	int32 InflateStatusCode;
-	while ((InflateStatusCode = inflate(&GzipStream, Z_SYNC_FLUSH)) == Z_OK)
+	while (true)
 	{
-		// Append the number of bytes decompressed to the output
-		const int32 BytesWritten = sizeof(LocalDecompressionBuffer) - GzipStream.avail_out;
-		OutDecompressedData.Append(LocalDecompressionBuffer, BytesWritten);
+		GzipStream.next_out = OutDecompressedData.GetData() + GzipStream.total_out;
+		GzipStream.avail_out = OutDecompressedData.Num() - GzipStream.total_out;
 
-		// Reset the next byte to the start of the buffer and available space to the entire buffer
-		GzipStream.next_out = LocalDecompressionBuffer;
-		GzipStream.avail_out = sizeof(LocalDecompressionBuffer);
+		InflateStatusCode = inflate(&GzipStream, Z_NO_FLUSH);
+		if (InflateStatusCode == Z_STREAM_END || (InflateStatusCode != Z_OK && InflateStatusCode != Z_BUF_ERROR))
+		{
+			break;
+		}
+		// Running out of input before the end of the stream means that the archive is truncated
+		if (GzipStream.avail_out != 0)
+		{
+			break;
+		}
+		// Output buffer is full, grow it by at least half of its size
+		const int64 NewOutputSize = (int64)OutDecompressedData.Num() + FMath::Max(OutDecompressedData.Num() / 2, MinOutputGrowthSize);
+		if (NewOutputSize >= MAX_int32)
+		{
+			break;
+		}
+		OutDecompressedData.SetNumUninitialized((int32)NewOutputSize);
 	}
+	const int32 BytesWritten = GzipStream.total_out;
 	inflateEnd(&GzipStream);
 
-	// Append final decompressed bytes to the output
-	const int32 BytesWritten = sizeof(LocalDecompressionBuffer) - GzipStream.avail_out;
-	OutDecompressedData.Append(LocalDecompressionBuffer, BytesWritten);
-	
+	// Trim the output to the number of bytes actually decompressed without reallocating it
+	OutDecompressedData.SetNum(BytesWritten, false);
 	return InflateStatusCode == Z_STREAM_END;
 }
 
+int64 FSuzieDecompressionHelper::GetGzipUncompressedSizeHint(const TConstArrayView<uint8> CompressedData)
+{
+	// Gzip member trailer ends with ISIZE, the size of the uncompressed data modulo 2^32 stored in little endian
+	constexpr int32 GzipHeaderSize = 10;
+	constexpr int32 GzipTrailerSize = 8;
+	if (CompressedData.Num() < GzipHeaderSize + GzipTrailerSize)
+	{
+		return INDEX_NONE;
+	}
+	const uint8* SizeBytes = CompressedData.GetData() + CompressedData.Num() - sizeof(uint32);
+	return (int64)SizeBytes[0] | ((int64)SizeBytes[1] << 8) | ((int64)SizeBytes[2] << 16) | ((int64)SizeBytes[3] << 24);
+}
+
 void* FSuzieDecompressionHelper::ZlibAlloc(void*, unsigned int size, unsigned int num)
 {
 	return FMemory::Malloc(size * num);
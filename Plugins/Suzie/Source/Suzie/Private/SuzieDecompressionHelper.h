@@ -5,8 +5,10 @@
 class FSuzieDecompressionHelper
 {
 public:
-	/** Decompresses memory with Gzip */
-	static bool DecompressMemoryGzip(const TArray<uint8>& CompressedData, TArray<uint8>& OutDecompressedData);
+	/** Decompresses memory with Gzip. Output is pre-sized from the archive trailer and inflated in place, without intermediate buffers */
+	static bool DecompressMemoryGzip(TConstArrayView<uint8> CompressedData, TArray<uint8>& OutDecompressedData);
+	/** Returns the uncompressed size recorded in the Gzip trailer (modulo 2^32), or INDEX_NONE if the data is too short to be a Gzip archive */
+	static int64 GetGzipUncompressedSizeHint(TConstArrayView<uint8> CompressedData);
 private:
 	static void* ZlibAlloc(void* opaque, unsigned int size, unsigned int num);
 	static void ZlibFree(void* opaque, void* p);
@@ -0,0 +1,517 @@
+#include "SuzieDumpCache.h"
+#include "SuziePlugin.h"
+#include "SuzieMappedFile.h"
+#include "SuzieNameTable.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Algo/AnyOf.h"
+#include "Algo/Count.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace SuzieDumpCache
+{
+	// "SUZC" in little endian
+	constexpr uint32 CacheMagic = 0x435A5553;
+	// Must be bumped whenever the layout of the cache file changes
+	constexpr uint32 CacheFormatVersion = 2;
+	// String index of the names that are not set
+	constexpr uint32 NoneStringIndex = MAX_uint32;
+	// Object path, outer path, object name, class path, super struct path, class default object path, four flag fields, child count and the definition record tag
+	constexpr int64 MinObjectRecordSize = 10 * sizeof(uint32) + sizeof(EDynamicObjectType) + sizeof(uint32) + 1;
+
+	// Fields of the object definitions that are decoded into the object records, and do not need to be stored in the definitions again
+	static const TCHAR* const RecordFieldNames[] = {TEXT("type"), TEXT("class"), TEXT("super_struct"), TEXT("class_default_object"), TEXT("children")};
+
+	// Tag preceding each value record in the value stream
+	enum class EValueRecord : uint8
+	{
+		Null,
+		False,
+		True,
+		// Followed by double
+		Number,
+		// Followed by uint32 string index
+		String,
+		// Followed by uint32 element count and element value records
+		Array,
+		// Followed by uint32 field count and (uint32 key string index, value record) pairs
+		Object,
+	};
+
+	// FString keys of TMap are case-insensitive by default, but strings in the table must be preserved exactly
+	struct FCaseSensitiveStringKeyFuncs : BaseKeyFuncs<TPair<FString, uint32>, FString, false>
+	{
+		static const FString& GetSetKey(const TPair<FString, uint32>& Element) { return Element.Key; }
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	class FCacheWriter
+	{
+	public:
+		TArray<FString> Strings;
+		TMap<FString, uint32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs> StringIndices;
+		TArray<uint8> ValueStream;
+
+		template<typename T>
+		void Write(TArray<uint8>& Buffer, const T Value)
+		{
+			Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+		}
+
+		uint32 FindOrAddString(const FString& String)
+		{
+			if (const uint32* ExistingIndex = StringIndices.Find(String))
+			{
+				return *ExistingIndex;
+			}
+			const uint32 NewIndex = Strings.Add(String);
+			StringIndices.Add(String, NewIndex);
+			return NewIndex;
+		}
+
+		void WriteValue(const TSharedPtr<FJsonValue>& Value)
+		{
+			if (!Value.IsValid())
+			{
+				Write(ValueStream, EValueRecord::Null);
+				return;
+			}
+			switch (Value->Type)
+			{
+			case EJson::Boolean:
+				Write(ValueStream, Value->AsBool() ? EValueRecord::True : EValueRecord::False);
+				break;
+			case EJson::Number:
+				Write(ValueStream, EValueRecord::Number);
+				Write(ValueStream, Value->AsNumber());
+				break;
+			case EJson::String:
+				Write(ValueStream, EValueRecord::String);
+				Write(ValueStream, FindOrAddString(Value->AsString()));
+				break;
+			case EJson::Array:
+				{
+					const TArray<TSharedPtr<FJsonValue>>& Elements = Value->AsArray();
+					Write(ValueStream, EValueRecord::Array);
+					Write(ValueStream, (uint32)Elements.Num());
+					for (const TSharedPtr<FJsonValue>& Element : Elements)
+					{
+						WriteValue(Element);
+					}
+					break;
+				}
+			case EJson::Object:
+				WriteObject(Value->AsObject());
+				break;
+			default:
+				Write(ValueStream, EValueRecord::Null);
+				break;
+			}
+		}
+
+		void WriteObject(const TSharedPtr<FJsonObject>& Object, const TConstArrayView<const TCHAR*> SkippedFieldNames = {})
+		{
+			if (!Object.IsValid())
+			{
+				Write(ValueStream, EValueRecord::Null);
+				return;
+			}
+			const auto IsSkippedField = [&](const FString& FieldName)
+			{
+				return Algo::AnyOf(SkippedFieldNames, [&](const TCHAR* SkippedFieldName) { return FieldName == SkippedFieldName; });
+			};
+			Write(ValueStream, EValueRecord::Object);
+			Write(ValueStream, (uint32)Algo::CountIf(Object->Values, [&](const TPair<FString, TSharedPtr<FJsonValue>>& Field) { return !IsSkippedField(Field.Key); }));
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object->Values)
+			{
+				if (!IsSkippedField(Field.Key))
+				{
+					Write(ValueStream, FindOrAddString(Field.Key));
+					WriteValue(Field.Value);
+				}
+			}
+		}
+
+		void WriteName(const FName Name)
+		{
+			Write(ValueStream, Name.IsNone() ? NoneStringIndex : FindOrAddString(Name.ToString()));
+		}
+
+		void WriteObjectRecord(const FDynamicObjectRecord& ObjectRecord)
+		{
+			WriteName(ObjectRecord.ObjectPath);
+			WriteName(ObjectRecord.OuterPath);
+			WriteName(ObjectRecord.ObjectName);
+			Write(ValueStream, ObjectRecord.Type);
+			WriteName(ObjectRecord.ClassPath);
+			WriteName(ObjectRecord.SuperStructPath);
+			WriteName(ObjectRecord.ClassDefaultObjectPath);
+			Write(ValueStream, (uint32)ObjectRecord.ObjectFlags);
+			Write(ValueStream, (uint32)ObjectRecord.ClassFlags);
+			Write(ValueStream, (uint32)ObjectRecord.StructFlags);
+			Write(ValueStream, (uint32)ObjectRecord.FunctionFlags);
+			Write(ValueStream, (uint32)ObjectRecord.Children.Num());
+			for (const int32 ChildRecordIndex : ObjectRecord.Children)
+			{
+				Write(ValueStream, (uint32)ChildRecordIndex);
+			}
+			WriteObject(ObjectRecord.Definition, RecordFieldNames);
+		}
+	};
+
+	class FCacheReader
+	{
+	public:
+		const uint8* Cursor;
+		const uint8* End;
+		bool bFailed{};
+		TArray<FString> Strings;
+
+		FCacheReader(const uint8* InData, const int64 InSize) : Cursor(InData), End(InData + InSize) {}
+
+		template<typename T>
+		T Read()
+		{
+			T Value{};
+			if (bFailed || End - Cursor < (int64)sizeof(T))
+			{
+				bFailed = true;
+				return Value;
+			}
+			FMemory::Memcpy(&Value, Cursor, sizeof(T));
+			Cursor += sizeof(T);
+			return Value;
+		}
+
+		bool ReadStringTable()
+		{
+			const uint32 StringCount = Read<uint32>();
+			// Each string occupies at least its length prefix, which bounds the reservation for corrupted files
+			if (bFailed || StringCount > (End - Cursor) / sizeof(uint32))
+			{
+				return false;
+			}
+			Strings.Reserve(StringCount);
+			for (uint32 StringIndex = 0; StringIndex < StringCount; StringIndex++)
+			{
+				const uint32 StringLength = Read<uint32>();
+				if (bFailed || End - Cursor < StringLength)
+				{
+					return false;
+				}
+				const FUTF8ToTCHAR StringConversion(reinterpret_cast<const ANSICHAR*>(Cursor), StringLength);
+				Strings.Emplace(StringConversion.Length(), StringConversion.Get());
+				Cursor += StringLength;
+			}
+			return true;
+		}
+
+		const FString* ReadStringReference()
+		{
+			const uint32 StringIndex = Read<uint32>();
+			if (bFailed || !Strings.IsValidIndex(StringIndex))
+			{
+				bFailed = true;
+				return nullptr;
+			}
+			return &Strings[StringIndex];
+		}
+
+		TSharedPtr<FJsonObject> ReadObjectBody()
+		{
+			const uint32 FieldCount = Read<uint32>();
+			// Each field occupies at least its key index and value record tag
+			if (bFailed || FieldCount > (End - Cursor) / (sizeof(uint32) + 1))
+			{
+				bFailed = true;
+				return nullptr;
+			}
+			TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->Values.Reserve(FieldCount);
+			for (uint32 FieldIndex = 0; FieldIndex < FieldCount && !bFailed; FieldIndex++)
+			{
+				const FString* Key = ReadStringReference();
+				TSharedPtr<FJsonValue> Value = ReadValue();
+				if (Key)
+				{
+					Object->Values.Add(*Key, MoveTemp(Value));
+				}
+			}
+			return Object;
+		}
+
+		TSharedPtr<FJsonValue> ReadValue()
+		{
+			switch (Read<EValueRecord>())
+			{
+			case EValueRecord::Null:
+				return MakeShared<FJsonValueNull>();
+			case EValueRecord::False:
+				return MakeShared<FJsonValueBoolean>(false);
+			case EValueRecord::True:
+				return MakeShared<FJsonValueBoolean>(true);
+			case EValueRecord::Number:
+				return MakeShared<FJsonValueNumber>(Read<double>());
+			case EValueRecord::String:
+				{
+					const FString* String = ReadStringReference();
+					if (String == nullptr)
+					{
+						return nullptr;
+					}
+					return MakeShared<FJsonValueString>(*String);
+				}
+			case EValueRecord::Array:
+				{
+					const uint32 ElementCount = Read<uint32>();
+					// Each element occupies at least its value record tag
+					if (bFailed || ElementCount > (uint64)(End - Cursor))
+					{
+						bFailed = true;
+						return nullptr;
+					}
+					TArray<TSharedPtr<FJsonValue>> Elements;
+					Elements.Reserve(ElementCount);
+					for (uint32 ElementIndex = 0; ElementIndex < ElementCount && !bFailed; ElementIndex++)
+					{
+						Elements.Add(ReadValue());
+					}
+					return MakeShared<FJsonValueArray>(Elements);
+				}
+			case EValueRecord::Object:
+				return MakeShared<FJsonValueObject>(ReadObjectBody());
+			default:
+				bFailed = true;
+				return nullptr;
+			}
+		}
+
+		const FString* ReadOptionalStringReference()
+		{
+			const uint32 StringIndex = Read<uint32>();
+			if (bFailed || StringIndex == NoneStringIndex)
+			{
+				return nullptr;
+			}
+			if (!Strings.IsValidIndex(StringIndex))
+			{
+				bFailed = true;
+				return nullptr;
+			}
+			return &Strings[StringIndex];
+		}
+
+		/** Reads a name that generation looks up repeatedly, e.g. a class path. These are interned in the name table of the context */
+		FName ReadInternedName(FSuzieNameTable& NameTable)
+		{
+			const FString* String = ReadOptionalStringReference();
+			return String ? NameTable.FindOrAdd(*String) : NAME_None;
+		}
+
+		/** Reads a unique name, e.g. an object path. Names are created once per string of the table */
+		FName ReadName()
+		{
+			const FString* String = ReadOptionalStringReference();
+			if (String == nullptr)
+			{
+				return NAME_None;
+			}
+			FName& Name = StringNames[String - Strings.GetData()];
+			if (Name.IsNone())
+			{
+				Name = FName(*String);
+			}
+			return Name;
+		}
+
+		/** Decodes the object records directly into the generation context, without building the document and indexing it again */
+		TSharedPtr<FDynamicClassGenerationContext> ReadGenerationContext()
+		{
+			const uint32 RecordCount = Read<uint32>();
+			if (bFailed || RecordCount > (End - Cursor) / MinObjectRecordSize)
+			{
+				return nullptr;
+			}
+			StringNames.SetNum(Strings.Num());
+
+			const TSharedPtr<FDynamicClassGenerationContext> Context = MakeShared<FDynamicClassGenerationContext>();
+			Context->ObjectRecords.SetNum(RecordCount);
+			Context->ObjectRecordIndices.Reserve(RecordCount);
+			for (uint32 RecordIndex = 0; RecordIndex < RecordCount && !bFailed; RecordIndex++)
+			{
+				FDynamicObjectRecord& ObjectRecord = Context->ObjectRecords[RecordIndex];
+				ObjectRecord.ObjectPath = ReadName();
+				ObjectRecord.OuterPath = ReadInternedName(*Context->NameTable);
+				ObjectRecord.ObjectName = ReadInternedName(*Context->NameTable);
+				ObjectRecord.Type = Read<EDynamicObjectType>();
+				ObjectRecord.ClassPath = ReadInternedName(*Context->NameTable);
+				ObjectRecord.SuperStructPath = ReadInternedName(*Context->NameTable);
+				ObjectRecord.ClassDefaultObjectPath = ReadName();
+				ObjectRecord.ObjectFlags = (EObjectFlags)Read<uint32>();
+				ObjectRecord.ClassFlags = (EClassFlags)Read<uint32>();
+				ObjectRecord.StructFlags = (EStructFlags)Read<uint32>();
+				ObjectRecord.FunctionFlags = (EFunctionFlags)Read<uint32>();
+				if (ObjectRecord.Type > EDynamicObjectType::Object)
+				{
+					bFailed = true;
+					break;
+				}
+
+				const uint32 ChildCount = Read<uint32>();
+				if (bFailed || ChildCount > (End - Cursor) / sizeof(uint32))
+				{
+					bFailed = true;
+					break;
+				}
+				ObjectRecord.Children.SetNumUninitialized(ChildCount);
+				for (uint32 ChildIndex = 0; ChildIndex < ChildCount; ChildIndex++)
+				{
+					const uint32 ChildRecordIndex = Read<uint32>();
+					bFailed |= ChildRecordIndex >= RecordCount;
+					ObjectRecord.Children[ChildIndex] = (int32)ChildRecordIndex;
+				}
+
+				if (Read<EValueRecord>() != EValueRecord::Object)
+				{
+					bFailed = true;
+					break;
+				}
+				ObjectRecord.Definition = ReadObjectBody();
+				Context->ObjectRecordIndices.Add(ObjectRecord.ObjectPath, RecordIndex);
+			}
+			return bFailed ? nullptr : Context;
+		}
+
+	private:
+		/** Names created from the strings of the table, by string index */
+		TArray<FName> StringNames;
+	};
+
+	// Identifies the source file and the engine the cache was produced for. Written field by field, so there is no padding to worry about
+	struct FCacheHeader
+	{
+		uint32 Magic{};
+		uint32 FormatVersion{};
+		uint64 SourceHash{};
+		uint32 EngineMajor{};
+		uint32 EngineMinor{};
+		uint32 EnginePatch{};
+		uint32 EngineChangelist{};
+
+		static FCacheHeader MakeCurrent(const uint64 SourceHash)
+		{
+			const FEngineVersion& EngineVersion = FEngineVersion::Current();
+			return {CacheMagic, CacheFormatVersion, SourceHash, EngineVersion.GetMajor(), EngineVersion.GetMinor(), EngineVersion.GetPatch(), EngineVersion.GetChangelist()};
+		}
+
+		bool operator==(const FCacheHeader& Other) const
+		{
+			return Magic == Other.Magic && FormatVersion == Other.FormatVersion && SourceHash == Other.SourceHash && EngineMajor == Other.EngineMajor &&
+				EngineMinor == Other.EngineMinor && EnginePatch == Other.EnginePatch && EngineChangelist == Other.EngineChangelist;
+		}
+	};
+}
+
+FString FSuzieDumpCache::GetCacheFilePath(const FString& SourceFilePath)
+{
+	// Dumps with the same file name in different directories must not share the cache file, so the name includes a hash of the full source path
+	// Hash is taken from the lowercase path since the same file can be referred to with a different case on case-insensitive file systems
+	FString FullSourceFilePath = FPaths::ConvertRelativePathToFull(SourceFilePath);
+	FPaths::NormalizeFilename(FullSourceFilePath);
+	const FTCHARToUTF8 FullSourceFilePathConversion(*FullSourceFilePath.ToLower());
+	const uint64 SourcePathHash = FXxHash64::HashBuffer(FullSourceFilePathConversion.Get(), FullSourceFilePathConversion.Length()).Hash;
+
+	return FPaths::ProjectIntermediateDir() / TEXT("Suzie") / FString::Printf(TEXT("%s.%016llx.suziecache"), *FPaths::GetCleanFilename(SourceFilePath), SourcePathHash);
+}
+
+uint64 FSuzieDumpCache::HashSourceFileContents(const uint8* Data, const int64 Size)
+{
+	return FXxHash64::HashBuffer(Data, Size).Hash;
+}
+
+TSharedPtr<FDynamicClassGenerationContext> FSuzieDumpCache::Load(const FString& CacheFilePath, const uint64 SourceHash)
+{
+	using namespace SuzieDumpCache;
+
+	if (!IFileManager::Get().FileExists(*CacheFilePath))
+	{
+		return nullptr;
+	}
+	const TUniquePtr<FSuzieMappedFile> CacheFile = FSuzieMappedFile::Open(CacheFilePath);
+	if (!CacheFile)
+	{
+		return nullptr;
+	}
+
+	FCacheReader Reader(CacheFile->GetData(), CacheFile->GetSize());
+	FCacheHeader Header;
+	Header.Magic = Reader.Read<uint32>();
+	Header.FormatVersion = Reader.Read<uint32>();
+	Header.SourceHash = Reader.Read<uint64>();
+	Header.EngineMajor = Reader.Read<uint32>();
+	Header.EngineMinor = Reader.Read<uint32>();
+	Header.EnginePatch = Reader.Read<uint32>();
+	Header.EngineChangelist = Reader.Read<uint32>();
+
+	// Cache is stale if it has been written for a different version of the source file or a different engine
+	if (Reader.bFailed || !(Header == FCacheHeader::MakeCurrent(SourceHash)))
+	{
+		UE_LOG(LogSuzie, Display, TEXT("Class definition cache %s is stale"), *FPaths::GetCleanFilename(CacheFilePath));
+		return nullptr;
+	}
+
+	TSharedPtr<FDynamicClassGenerationContext> Context = Reader.ReadStringTable() ? Reader.ReadGenerationContext() : nullptr;
+	if (!Context.IsValid() || Reader.bFailed || Reader.Cursor != Reader.End)
+	{
+		UE_LOG(LogSuzie, Warning, TEXT("Class definition cache %s is corrupted"), *FPaths::GetCleanFilename(CacheFilePath));
+		return nullptr;
+	}
+	return Context;
+}
+
+bool FSuzieDumpCache::Save(const FString& CacheFilePath, const uint64 SourceHash, const FDynamicClassGenerationContext& Context)
+{
+	using namespace SuzieDumpCache;
+
+	// Value stream is written first since it populates the string table
+	FCacheWriter Writer;
+	Writer.Write(Writer.ValueStream, (uint32)Context.ObjectRecords.Num());
+	for (const FDynamicObjectRecord& ObjectRecord : Context.ObjectRecords)
+	{
+		Writer.WriteObjectRecord(ObjectRecord);
+	}
+
+	TArray<uint8> CacheFileContents;
+	const FCacheHeader Header = FCacheHeader::MakeCurrent(SourceHash);
+	Writer.Write(CacheFileContents, Header.Magic);
+	Writer.Write(CacheFileContents, Header.FormatVersion);
+	Writer.Write(CacheFileContents, Header.SourceHash);
+	Writer.Write(CacheFileContents, Header.EngineMajor);
+	Writer.Write(CacheFileContents, Header.EngineMinor);
+	Writer.Write(CacheFileContents, Header.EnginePatch);
+	Writer.Write(CacheFileContents, Header.EngineChangelist);
+
+	Writer.Write(CacheFileContents, (uint32)Writer.Strings.Num());
+	for (const FString& String : Writer.Strings)
+	{
+		const FTCHARToUTF8 StringConversion(*String, String.Len());
+		Writer.Write(CacheFileContents, (uint32)StringConversion.Length());
+		CacheFileContents.Append(reinterpret_cast<const uint8*>(StringConversion.Get()), StringConversion.Length());
+	}
+	CacheFileContents.Append(Writer.ValueStream);
+
+	// Write to a temporary file first so that an interrupted write never leaves a truncated cache behind
+	const FString TempCacheFilePath = CacheFilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(CacheFileContents, *TempCacheFilePath) || !IFileManager::Get().Move(*CacheFilePath, *TempCacheFilePath))
+	{
+		UE_LOG(LogSuzie, Warning, TEXT("Failed to write class definition cache %s"), *CacheFilePath);
+		IFileManager::Get().Delete(*TempCacheFilePath);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FDynamicClassGenerationContext;
+
+/**
+ * Binary pre-compiled form of a parsed class definition file, stored in the Intermediate directory of the project.
+ * The file starts with a header identifying the hash of the source file and the engine version it was written with,
+ * followed by a table of unique strings and the object records of the generation context that reference strings by index.
+ * Records are stored already decoded (names, flags and child indices), followed by the definition fields that are only read once,
+ * e.g. properties and property values, as a flat, prefix-ordered stream of value records.
+ * Loading it creates the generation context directly, without parsing the document or indexing its objects again.
+ */
+class FSuzieDumpCache
+{
+public:
+	/** Returns the path of the cache file for the given class definition file */
+	static FString GetCacheFilePath(const FString& SourceFilePath);
+	/** Computes the hash of the raw source file contents that the cache is keyed on */
+	static uint64 HashSourceFileContents(const uint8* Data, int64 Size);
+	/** Loads the object records from the cache file. Returns null if there is no cache, or it was written for a different source file hash or engine version */
+	static TSharedPtr<FDynamicClassGenerationContext> Load(const FString& CacheFilePath, uint64 SourceHash);
+	/** Writes the object records of the context into the cache file, replacing the existing cache. Definitions of the records must not have been released yet */
+	static bool Save(const FString& CacheFilePath, uint64 SourceHash, const FDynamicClassGenerationContext& Context);
+};
@@ -0,0 +1,371 @@
+#include "SuzieDumpDiff.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+namespace SuzieDumpDiff
+{
+	/** Fields holding the dumped flags of an object, compared as sets of flag names */
+	static const TCHAR* const FlagFieldNames[] = {TEXT("object_flags"), TEXT("class_flags"), TEXT("struct_flags"), TEXT("function_flags")};
+
+	/** Case sensitive, unlike GetTypeHash of a string, since renaming a property only by case is still a change */
+	static uint32 HashString(const FString& String)
+	{
+		return FCrc::MemCrc32(*String, String.Len() * sizeof(TCHAR));
+	}
+
+	static uint32 HashJsonValue(const TSharedPtr<FJsonValue>& Value);
+
+	/** Fields are hashed independently of their order, so that only the contents of the object matter */
+	static uint32 HashJsonObject(const FJsonObject& Object)
+	{
+		uint32 Hash = Object.Values.Num();
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+		{
+			Hash += HashCombine(HashString(Field.Key), HashJsonValue(Field.Value));
+		}
+		return Hash;
+	}
+
+	static uint32 HashJsonValue(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return 0;
+		}
+		switch (Value->Type)
+		{
+		case EJson::String: return HashCombine(1, HashString(Value->AsString()));
+		case EJson::Number: return HashCombine(2, GetTypeHash(Value->AsNumber()));
+		case EJson::Boolean: return Value->AsBool() ? 3 : 4;
+		case EJson::Array:
+		{
+			uint32 Hash = 5;
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+			{
+				Hash = HashCombine(Hash, HashJsonValue(Element));
+			}
+			return Hash;
+		}
+		case EJson::Object: return HashCombine(6, HashJsonObject(*Value->AsObject()));
+		default: return 0;
+		}
+	}
+
+	static uint32 HashJsonField(const FJsonObject& Object, const TCHAR* FieldName)
+	{
+		return HashJsonValue(Object.TryGetField(FieldName));
+	}
+
+	/** Returns the property descriptors of a struct or function by name */
+	static TMap<FString, TSharedPtr<FJsonObject>> GetPropertiesByName(const FJsonObject& Definition)
+	{
+		TMap<FString, TSharedPtr<FJsonObject>> PropertiesByName;
+		const TArray<TSharedPtr<FJsonValue>>* Properties;
+		if (Definition.TryGetArrayField(TEXT("properties"), Properties))
+		{
+			for (const TSharedPtr<FJsonValue>& PropertyValue : *Properties)
+			{
+				const TSharedPtr<FJsonObject>* Property;
+				if (PropertyValue->TryGetObject(Property))
+				{
+					PropertiesByName.Add((*Property)->GetStringField(TEXT("name")), *Property);
+				}
+			}
+		}
+		return PropertiesByName;
+	}
+
+	/** Splits dumped flags (e.g. "CPF_Edit | CPF_Transient") into the set of flag names */
+	static TSet<FString> GetFlagNames(const FJsonObject& Definition, const TCHAR* FieldName)
+	{
+		TSet<FString> FlagNames;
+		FString Flags;
+		if (Definition.TryGetStringField(FieldName, Flags))
+		{
+			TArray<FString> FlagNameArray;
+			Flags.ParseIntoArray(FlagNameArray, TEXT("|"));
+			for (FString& FlagName : FlagNameArray)
+			{
+				FlagName.TrimStartAndEndInline();
+				if (!FlagName.IsEmpty())
+				{
+					FlagNames.Add(MoveTemp(FlagName));
+				}
+			}
+		}
+		return FlagNames;
+	}
+
+	static void AppendPropertyChanges(const FJsonObject& OldDefinition, const FJsonObject& NewDefinition, TArray<FString>& OutChanges)
+	{
+		TMap<FString, TSharedPtr<FJsonObject>> OldProperties = GetPropertiesByName(OldDefinition);
+		const TMap<FString, TSharedPtr<FJsonObject>> NewProperties = GetPropertiesByName(NewDefinition);
+		for (const TPair<FString, TSharedPtr<FJsonObject>>& NewProperty : NewProperties)
+		{
+			const FString NewType = NewProperty.Value->GetStringField(TEXT("type"));
+			TSharedPtr<FJsonObject> OldProperty;
+			if (!OldProperties.RemoveAndCopyValue(NewProperty.Key, OldProperty))
+			{
+				OutChanges.Add(FString::Printf(TEXT("+ property %s (%s)"), *NewProperty.Key, *NewType));
+				continue;
+			}
+			const FString OldType = OldProperty->GetStringField(TEXT("type"));
+			if (OldType != NewType)
+			{
+				OutChanges.Add(FString::Printf(TEXT("~ property %s: %s -> %s"), *NewProperty.Key, *OldType, *NewType));
+			}
+			else if (HashJsonObject(*OldProperty) != HashJsonObject(*NewProperty.Value))
+			{
+				OutChanges.Add(FString::Printf(TEXT("~ property %s (%s)"), *NewProperty.Key, *NewType));
+			}
+		}
+		for (const TPair<FString, TSharedPtr<FJsonObject>>& RemovedProperty : OldProperties)
+		{
+			OutChanges.Add(FString::Printf(TEXT("- property %s (%s)"), *RemovedProperty.Key, *RemovedProperty.Value->GetStringField(TEXT("type"))));
+		}
+	}
+
+	static void AppendValueChanges(const FJsonObject& OldDefinition, const FJsonObject& NewDefinition, TArray<FString>& OutChanges)
+	{
+		const TSharedPtr<FJsonObject>* OldValues = nullptr;
+		const TSharedPtr<FJsonObject>* NewValues = nullptr;
+		OldDefinition.TryGetObjectField(TEXT("property_values"), OldValues);
+		NewDefinition.TryGetObjectField(TEXT("property_values"), NewValues);
+
+		TArray<FString> ChangedValueNames;
+		if (NewValues)
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& NewValue : (*NewValues)->Values)
+			{
+				const TSharedPtr<FJsonValue> OldValue = OldValues ? (*OldValues)->TryGetField(NewValue.Key) : TSharedPtr<FJsonValue>();
+				if (HashJsonValue(OldValue) != HashJsonValue(NewValue.Value))
+				{
+					ChangedValueNames.Add(NewValue.Key);
+				}
+			}
+		}
+		if (OldValues)
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& OldValue : (*OldValues)->Values)
+			{
+				if (!NewValues || !(*NewValues)->HasField(OldValue.Key))
+				{
+					ChangedValueNames.Add(OldValue.Key);
+				}
+			}
+		}
+		if (!ChangedValueNames.IsEmpty())
+		{
+			OutChanges.Add(FString::Printf(TEXT("~ values of %s"), *FString::Join(ChangedValueNames, TEXT(", "))));
+		}
+	}
+}
+
+FSuzieDumpSignature FSuzieDumpSignature::Create(const FDynamicClassGenerationContext& Context)
+{
+	using namespace SuzieDumpDiff;
+	TRACE_CPUPROFILER_EVENT_SCOPE(Suzie_CreateDumpSignature);
+
+	FSuzieDumpSignature DumpSignature;
+	DumpSignature.Objects.Reserve(Context.ObjectRecords.Num());
+	for (const FDynamicObjectRecord& ObjectRecord : Context.ObjectRecords)
+	{
+		checkf(ObjectRecord.Definition.IsValid(), TEXT("Definition of %s has been released before the dump signature was created"), *ObjectRecord.ObjectPath.ToString());
+		const FJsonObject& Definition = *ObjectRecord.Definition;
+
+		FSuzieObjectSignature& Signature = DumpSignature.Objects.Add(ObjectRecord.ObjectPath);
+		Signature.Type = ObjectRecord.Type;
+		switch (ObjectRecord.Type)
+		{
+		case EDynamicObjectType::Class:
+		case EDynamicObjectType::ScriptStruct:
+			Signature.LayoutHash = HashCombine(GetTypeHash(ObjectRecord.SuperStructPath), HashJsonField(Definition, TEXT("properties")));
+			break;
+		case EDynamicObjectType::Function:
+			Signature.LayoutHash = HashJsonField(Definition, TEXT("properties"));
+			break;
+		case EDynamicObjectType::Enum:
+			Signature.LayoutHash = HashJsonField(Definition, TEXT("names"));
+			break;
+		case EDynamicObjectType::Object:
+			Signature.LayoutHash = GetTypeHash(ObjectRecord.ClassPath);
+			Signature.ValuesHash = HashJsonField(Definition, TEXT("property_values"));
+			break;
+		}
+		Signature.FlagsHash = HashCombine(HashCombine(GetTypeHash((uint32)ObjectRecord.ObjectFlags), GetTypeHash((uint32)ObjectRecord.ClassFlags)),
+			HashCombine(GetTypeHash((uint32)ObjectRecord.StructFlags), GetTypeHash((uint32)ObjectRecord.FunctionFlags)));
+	}
+	return DumpSignature;
+}
+
+FSuzieDumpDiff FSuzieDumpDiff::Compare(const FSuzieDumpSignature& OldDump, const FSuzieDumpSignature& NewDump)
+{
+	FSuzieDumpDiff Diff;
+	for (const TPair<FName, FSuzieObjectSignature>& NewObject : NewDump.Objects)
+	{
+		ESuzieObjectChange Changes = ESuzieObjectChange::None;
+		if (const FSuzieObjectSignature* OldSignature = OldDump.Objects.Find(NewObject.Key))
+		{
+			const FSuzieObjectSignature& NewSignature = NewObject.Value;
+			if (OldSignature->Type != NewSignature.Type || OldSignature->LayoutHash != NewSignature.LayoutHash)
+			{
+				Changes |= ESuzieObjectChange::Layout;
+			}
+			if (OldSignature->FlagsHash != NewSignature.FlagsHash)
+			{
+				Changes |= ESuzieObjectChange::Flags;
+			}
+			if (OldSignature->ValuesHash != NewSignature.ValuesHash)
+			{
+				Changes |= ESuzieObjectChange::Values;
+			}
+		}
+		else
+		{
+			Changes = ESuzieObjectChange::Added;
+		}
+
+		if (Changes == ESuzieObjectChange::None)
+		{
+			Diff.NumUnchanged++;
+		}
+		else
+		{
+			Diff.Objects.Add({NewObject.Key, NewObject.Value.Type, Changes});
+		}
+	}
+	for (const TPair<FName, FSuzieObjectSignature>& OldObject : OldDump.Objects)
+	{
+		if (!NewDump.Objects.Contains(OldObject.Key))
+		{
+			Diff.Objects.Add({OldObject.Key, OldObject.Value.Type, ESuzieObjectChange::Removed});
+		}
+	}
+	return Diff;
+}
+
+TArray<FString> FSuzieDumpDiff::DescribeChanges(const FDynamicObjectRecord& OldRecord, const FDynamicObjectRecord& NewRecord)
+{
+	using namespace SuzieDumpDiff;
+	TArray<FString> Changes;
+	if (!OldRecord.Definition.IsValid() || !NewRecord.Definition.IsValid())
+	{
+		return Changes;
+	}
+	const FJsonObject& OldDefinition = *OldRecord.Definition;
+	const FJsonObject& NewDefinition = *NewRecord.Definition;
+
+	if (OldRecord.Type != NewRecord.Type)
+	{
+		Changes.Add(FString::Printf(TEXT("~ type: %s -> %s"), GetObjectTypeName(OldRecord.Type), GetObjectTypeName(NewRecord.Type)));
+		return Changes;
+	}
+	if (OldRecord.SuperStructPath != NewRecord.SuperStructPath)
+	{
+		Changes.Add(FString::Printf(TEXT("~ parent: %s -> %s"), *OldRecord.SuperStructPath.ToString(), *NewRecord.SuperStructPath.ToString()));
+	}
+	if (OldRecord.ClassPath != NewRecord.ClassPath)
+	{
+		Changes.Add(FString::Printf(TEXT("~ class: %s -> %s"), *OldRecord.ClassPath.ToString(), *NewRecord.ClassPath.ToString()));
+	}
+	if (NewRecord.Type == EDynamicObjectType::Enum && HashJsonField(OldDefinition, TEXT("names")) != HashJsonField(NewDefinition, TEXT("names")))
+	{
+		Changes.Add(TEXT("~ enum names"));
+	}
+	AppendPropertyChanges(OldDefinition, NewDefinition, Changes);
+
+	for (const TCHAR* FlagFieldName : FlagFieldNames)
+	{
+		const TSet<FString> OldFlagNames = GetFlagNames(OldDefinition, FlagFieldName);
+		const TSet<FString> NewFlagNames = GetFlagNames(NewDefinition, FlagFieldName);
+		TArray<FString> FlagChanges;
+		for (const FString& FlagName : NewFlagNames.Difference(OldFlagNames))
+		{
+			FlagChanges.Add(TEXT("+") + FlagName);
+		}
+		for (const FString& FlagName : OldFlagNames.Difference(NewFlagNames))
+		{
+			FlagChanges.Add(TEXT("-") + FlagName);
+		}
+		if (!FlagChanges.IsEmpty())
+		{
+			Changes.Add(FString::Printf(TEXT("~ %s: %s"), FlagFieldName, *FString::Join(FlagChanges, TEXT(" "))));
+		}
+	}
+
+	AppendValueChanges(OldDefinition, NewDefinition, Changes);
+	return Changes;
+}
+
+FString FSuzieDumpDiff::CreateReport(const FDynamicClassGenerationContext* OldContext, const FDynamicClassGenerationContext* NewContext) const
+{
+	int32 NumAdded = 0;
+	int32 NumRemoved = 0;
+	for (const FSuzieObjectDiff& ObjectDiff : Objects)
+	{
+		NumAdded += EnumHasAnyFlags(ObjectDiff.Changes, ESuzieObjectChange::Added);
+		NumRemoved += EnumHasAnyFlags(ObjectDiff.Changes, ESuzieObjectChange::Removed);
+	}
+	TStringBuilder<4096> Report;
+	Report.Appendf(TEXT("%d added, %d removed, %d changed, %d unchanged objects. %d changes cannot be applied by hot reload and require an editor restart\n"),
+		NumAdded, NumRemoved, Objects.Num() - NumAdded - NumRemoved, NumUnchanged, GetNumRequiringRestart());
+
+	for (const FSuzieObjectDiff& ObjectDiff : Objects)
+	{
+		if (EnumHasAnyFlags(ObjectDiff.Changes, ESuzieObjectChange::Added | ESuzieObjectChange::Removed))
+		{
+			Report.Appendf(TEXT("%c %s %s\n"), EnumHasAnyFlags(ObjectDiff.Changes, ESuzieObjectChange::Added) ? TEXT('+') : TEXT('-'),
+				GetObjectTypeName(ObjectDiff.Type), *ObjectDiff.ObjectPath.ToString());
+			continue;
+		}
+
+		TArray<const TCHAR*, TInlineAllocator<3>> ChangeNames;
+		if (EnumHasAnyFlags(ObjectDiff.Changes, ESuzieObjectChange::Layout))
+		{
+			ChangeNames.Add(TEXT("layout"));
+		}
+		if (EnumHasAnyFlags(ObjectDiff.Changes, ESuzieObjectChange::Flags))
+		{
+			ChangeNames.Add(TEXT("flags"));
+		}
+		if (EnumHasAnyFlags(ObjectDiff.Changes, ESuzieObjectChange::Values))
+		{
+			ChangeNames.Add(TEXT("values"));
+		}
+		Report.Appendf(TEXT("~ %s %s [%s]\n"), GetObjectTypeName(ObjectDiff.Type), *ObjectDiff.ObjectPath.ToString(), *FString::Join(ChangeNames, TEXT(", ")));
+
+		const FDynamicObjectRecord* OldRecord = OldContext ? OldContext->FindObjectRecord(ObjectDiff.ObjectPath) : nullptr;
+		const FDynamicObjectRecord* NewRecord = NewContext ? NewContext->FindObjectRecord(ObjectDiff.ObjectPath) : nullptr;
+		if (OldRecord && NewRecord)
+		{
+			for (const FString& Change : DescribeChanges(*OldRecord, *NewRecord))
+			{
+				Report.Appendf(TEXT("    %s\n"), *Change);
+			}
+		}
+	}
+	return FString(Report.ToView());
+}
+
+int32 FSuzieDumpDiff::GetNumRequiringRestart() const
+{
+	// Removed objects are kept as they are, so they do not require a restart either
+	int32 NumRequiringRestart = 0;
+	for (const FSuzieObjectDiff& ObjectDiff : Objects)
+	{
+		NumRequiringRestart += EnumHasAnyFlags(ObjectDiff.Changes, ESuzieObjectChange::Layout | ESuzieObjectChange::Flags | ESuzieObjectChange::Values);
+	}
+	return NumRequiringRestart;
+}
+
+const TCHAR* FSuzieDumpDiff::GetObjectTypeName(const EDynamicObjectType Type)
+{
+	switch (Type)
+	{
+	case EDynamicObjectType::Class: return TEXT("Class");
+	case EDynamicObjectType::ScriptStruct: return TEXT("Struct");
+	case EDynamicObjectType::Enum: return TEXT("Enum");
+	case EDynamicObjectType::Function: return TEXT("Function");
+	default: return TEXT("Object");
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SuziePlugin.h"
+
+/** Ways an object can differ between two versions of a dump */
+enum class ESuzieObjectChange : uint8
+{
+	None = 0,
+	Added = 1 << 0,
+	Removed = 1 << 1,
+	/** Type of the object, parent struct, properties, function parameters, enum names or the class of an object */
+	Layout = 1 << 2,
+	/** Object, class, struct or function flags */
+	Flags = 1 << 3,
+	/** Property values of an object, e.g. the defaults of a class */
+	Values = 1 << 4,
+};
+ENUM_CLASS_FLAGS(ESuzieObjectChange);
+
+/** Hashes of the parts of an object definition that are compared between two versions of a dump */
+struct FSuzieObjectSignature
+{
+	EDynamicObjectType Type{EDynamicObjectType::Object};
+	uint32 LayoutHash{};
+	uint32 FlagsHash{};
+	uint32 ValuesHash{};
+};
+
+/** Signatures of all objects of a dump. A small fraction of the size of the parsed dump, so it can be kept around after the definitions have been released */
+struct FSuzieDumpSignature
+{
+	/** Key is the object path. Objects are in the order of the records they have been created from */
+	TMap<FName, FSuzieObjectSignature> Objects;
+
+	/** Computes the signatures of all records of the context. Has to be called before the definitions of the context are released */
+	static FSuzieDumpSignature Create(const FDynamicClassGenerationContext& Context);
+};
+
+struct FSuzieObjectDiff
+{
+	FName ObjectPath;
+	EDynamicObjectType Type{EDynamicObjectType::Object};
+	ESuzieObjectChange Changes{ESuzieObjectChange::None};
+};
+
+/**
+ * Structural difference between two versions of a dump, computed from their signatures.
+ * Drives hot reload, which generates the added objects and keeps everything else, and the SuzieDumpDiff commandlet report.
+ */
+class FSuzieDumpDiff
+{
+public:
+	/** Compares two dumps. Changed objects are listed in the order of the new dump, followed by the removed objects */
+	static FSuzieDumpDiff Compare(const FSuzieDumpSignature& OldDump, const FSuzieDumpSignature& NewDump);
+
+	/** Describes the individual changes of an object that exists in both dumps, one line per change. Needs the definitions of both versions */
+	static TArray<FString> DescribeChanges(const FDynamicObjectRecord& OldRecord, const FDynamicObjectRecord& NewRecord);
+
+	/**
+	 * Writes a summary followed by one line per added, removed or changed object.
+	 * Changes are described in detail when the contexts of both dumps are passed and still have their definitions.
+	 */
+	FString CreateReport(const FDynamicClassGenerationContext* OldContext = nullptr, const FDynamicClassGenerationContext* NewContext = nullptr) const;
+
+	/** Objects that exist in both dumps, but have changed in a way that cannot be applied to objects that have already been generated */
+	int32 GetNumRequiringRestart() const;
+
+	static const TCHAR* GetObjectTypeName(EDynamicObjectType Type);
+
+	/** Added, removed and changed objects. Unchanged objects are only counted */
+	TArray<FSuzieObjectDiff> Objects;
+	int32 NumUnchanged{};
+};
@@ -0,0 +1,71 @@
+#include "SuzieDumpDiffCommandlet.h"
+#include "SuziePlugin.h"
+#include "SuzieDumpDiff.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+USuzieDumpDiffCommandlet::USuzieDumpDiffCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+/** Parses and indexes the dump, keeping the definitions of the objects so that the changes can be described in detail */
+static TSharedPtr<FDynamicClassGenerationContext> LoadDumpForDiff(const FString& FilePath)
+{
+	EJsonClassDefinitionCompression Compression;
+	if (!FSuziePluginModule::GetJsonClassDefinitionFileCompression(FPaths::GetCleanFilename(FilePath), Compression))
+	{
+		UE_LOG(LogSuzie, Error, TEXT("%s is not a class definition file"), *FilePath);
+		return nullptr;
+	}
+	return FSuziePluginModule::LoadJsonClassDefinitionFile(FilePath, Compression);
+}
+
+int32 USuzieDumpDiffCommandlet::Main(const FString& Params)
+{
+	FString OldFilePath;
+	FString NewFilePath;
+	if (!FParse::Value(*Params, TEXT("Old="), OldFilePath) || !FParse::Value(*Params, TEXT("New="), NewFilePath))
+	{
+		UE_LOG(LogSuzie, Error, TEXT("Usage: -run=SuzieDumpDiff -Old=<FilePath> -New=<FilePath> [-Report=<FilePath>]"));
+		return 1;
+	}
+	const TSharedPtr<FDynamicClassGenerationContext> OldContext = LoadDumpForDiff(OldFilePath);
+	const TSharedPtr<FDynamicClassGenerationContext> NewContext = LoadDumpForDiff(NewFilePath);
+	if (!OldContext.IsValid() || !NewContext.IsValid())
+	{
+		// Errors have already been reported by LoadJsonClassDefinitionFile
+		return 1;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FSuzieDumpDiff Diff = FSuzieDumpDiff::Compare(FSuzieDumpSignature::Create(*OldContext), FSuzieDumpSignature::Create(*NewContext));
+	const FString Report = Diff.CreateReport(OldContext.Get(), NewContext.Get());
+	UE_LOG(LogSuzie, Display, TEXT("Compared %d objects of %s with %d objects of %s in %.2f seconds"), OldContext->ObjectRecords.Num(), *OldFilePath,
+		NewContext->ObjectRecords.Num(), *NewFilePath, FPlatformTime::Seconds() - StartTime);
+
+	FString ReportFilePath;
+	if (FParse::Value(*Params, TEXT("Report="), ReportFilePath))
+	{
+		if (!FFileHelper::SaveStringToFile(Report, *ReportFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Failed to write the report to %s"), *ReportFilePath);
+			return 1;
+		}
+		UE_LOG(LogSuzie, Display, TEXT("%s"), *Report.Left(Report.Find(TEXT("\n"))));
+		UE_LOG(LogSuzie, Display, TEXT("Wrote the report to %s"), *ReportFilePath);
+	}
+	else
+	{
+		TArray<FString> ReportLines;
+		Report.ParseIntoArrayLines(ReportLines);
+		for (const FString& ReportLine : ReportLines)
+		{
+			UE_LOG(LogSuzie, Display, TEXT("%s"), *ReportLine);
+		}
+	}
+	return Diff.Objects.IsEmpty() ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SuzieDumpDiffCommandlet.generated.h"
+
+/**
+ * Compares two versions of a dump and reports the classes, structs, enums, functions and objects that have been added, removed or changed,
+ * along with the changed properties, flags and property values. Also reports how many of the changes hot reload can apply without restarting the editor.
+ *
+ *   UnrealEditor-Cmd <Project> -run=SuzieDumpDiff -SuzieNoStartupGeneration -Old=<FilePath> -New=<FilePath> [-Report=<FilePath>]
+ *
+ * The report is written to the log unless -Report is passed. Returns 0 if the dumps are identical, and 1 if they differ or could not be loaded.
+ */
+UCLASS()
+class USuzieDumpDiffCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	USuzieDumpDiffCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,393 @@
+#include "SuzieDumpShards.h"
+#include "SuziePlugin.h"
+#include "SuzieFramedCompression.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace SuzieDumpShards
+{
+	// Must be bumped whenever the layout of the manifest changes
+	constexpr int32 ManifestFormatVersion = 1;
+
+	// Fields of object and property definitions that hold paths of other objects the definition cannot be generated without.
+	// Property values are not included, object references in them are resolved once the default objects are populated
+	const TCHAR* const ReferenceFieldNames[] = {
+		TEXT("class"), TEXT("super_struct"), TEXT("struct"), TEXT("enum"), TEXT("property_class"), TEXT("meta_class"), TEXT("interface_class"), TEXT("signature_function"),
+	};
+
+	FString GetPackageName(const FString& ObjectPath)
+	{
+		int32 PackageNameEnd;
+		return ObjectPath.FindChar(TEXT('.'), PackageNameEnd) ? ObjectPath.Left(PackageNameEnd) : ObjectPath;
+	}
+
+	// Collects the referenced object paths from the definition and the nested property definitions, skipping the property values and children
+	void CollectReferencedObjectPaths(const FJsonObject& Definition, TArray<FString>& OutObjectPaths)
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Definition.Values)
+		{
+			if (Field.Key == TEXT("property_values") || Field.Key == TEXT("children"))
+			{
+				continue;
+			}
+			if (Field.Value->Type == EJson::String)
+			{
+				for (const TCHAR* ReferenceFieldName : ReferenceFieldNames)
+				{
+					if (Field.Key == ReferenceFieldName && !Field.Value->AsString().IsEmpty())
+					{
+						OutObjectPaths.Add(Field.Value->AsString());
+						break;
+					}
+				}
+			}
+			else if (Field.Value->Type == EJson::Object)
+			{
+				CollectReferencedObjectPaths(*Field.Value->AsObject(), OutObjectPaths);
+			}
+			else if (Field.Value->Type == EJson::Array)
+			{
+				for (const TSharedPtr<FJsonValue>& Element : Field.Value->AsArray())
+				{
+					if (Element->Type == EJson::Object)
+					{
+						CollectReferencedObjectPaths(*Element->AsObject(), OutObjectPaths);
+					}
+				}
+			}
+		}
+	}
+
+	// Tarjan's algorithm. Strongly connected components are emitted after all components they depend on, which is the order shards are generated in
+	struct FPackageComponentBuilder
+	{
+		const TArray<TArray<int32>>& PackageDependencies;
+		TArray<int32> VisitIndices;
+		TArray<int32> LowLinks;
+		TArray<bool> OnStack;
+		TArray<int32> Stack;
+		TArray<TArray<int32>> Components;
+		int32 NextVisitIndex{};
+
+		explicit FPackageComponentBuilder(const TArray<TArray<int32>>& InPackageDependencies) : PackageDependencies(InPackageDependencies)
+		{
+			VisitIndices.Init(INDEX_NONE, PackageDependencies.Num());
+			LowLinks.Init(INDEX_NONE, PackageDependencies.Num());
+			OnStack.Init(false, PackageDependencies.Num());
+		}
+
+		void Visit(const int32 PackageIndex)
+		{
+			VisitIndices[PackageIndex] = LowLinks[PackageIndex] = NextVisitIndex++;
+			Stack.Add(PackageIndex);
+			OnStack[PackageIndex] = true;
+
+			for (const int32 DependencyIndex : PackageDependencies[PackageIndex])
+			{
+				if (VisitIndices[DependencyIndex] == INDEX_NONE)
+				{
+					Visit(DependencyIndex);
+					LowLinks[PackageIndex] = FMath::Min(LowLinks[PackageIndex], LowLinks[DependencyIndex]);
+				}
+				else if (OnStack[DependencyIndex])
+				{
+					LowLinks[PackageIndex] = FMath::Min(LowLinks[PackageIndex], VisitIndices[DependencyIndex]);
+				}
+			}
+
+			if (LowLinks[PackageIndex] == VisitIndices[PackageIndex])
+			{
+				TArray<int32>& Component = Components.AddDefaulted_GetRef();
+				int32 ComponentPackageIndex;
+				do
+				{
+					ComponentPackageIndex = Stack.Pop();
+					OnStack[ComponentPackageIndex] = false;
+					Component.Add(ComponentPackageIndex);
+				}
+				while (ComponentPackageIndex != PackageIndex);
+				Component.Sort();
+			}
+		}
+	};
+
+	bool WriteShardFile(const TSharedRef<FJsonObject>& ShardRootObject, const FString& FilePath, const bool bCompress)
+	{
+		FString Document;
+		const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Document);
+		if (!FJsonSerializer::Serialize(ShardRootObject, Writer))
+		{
+			return false;
+		}
+		const FTCHARToUTF8 Utf8Document(*Document, Document.Len());
+		const TConstArrayView<uint8> DocumentBytes(reinterpret_cast<const uint8*>(Utf8Document.Get()), Utf8Document.Length());
+		if (!bCompress)
+		{
+			return FFileHelper::SaveArrayToFile(DocumentBytes, *FilePath);
+		}
+		TArray<uint8> CompressedDocument;
+		return FSuzieFramedCompression::CompressMemory(DocumentBytes, CompressedDocument) && FFileHelper::SaveArrayToFile(CompressedDocument, *FilePath);
+	}
+}
+
+FString FSuzieShardManifest::GetManifestFilePath(const FString& ShardDirectory)
+{
+	return ShardDirectory / TEXT("manifest.json");
+}
+
+bool FSuzieShardManifest::Load(const FString& ShardDirectory, FSuzieShardManifest& OutManifest)
+{
+	using namespace SuzieDumpShards;
+
+	FString ManifestContents;
+	if (!FFileHelper::LoadFileToString(ManifestContents, *GetManifestFilePath(ShardDirectory)))
+	{
+		return false;
+	}
+	TSharedPtr<FJsonObject> ManifestObject;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ManifestContents), ManifestObject) || !ManifestObject.IsValid())
+	{
+		return false;
+	}
+	int32 Version = 0;
+	const TArray<TSharedPtr<FJsonValue>>* ShardValues;
+	if (!ManifestObject->TryGetNumberField(TEXT("version"), Version) || Version != ManifestFormatVersion || !ManifestObject->TryGetArrayField(TEXT("shards"), ShardValues))
+	{
+		return false;
+	}
+
+	OutManifest.Shards.Reset();
+	for (const TSharedPtr<FJsonValue>& ShardValue : *ShardValues)
+	{
+		const TSharedPtr<FJsonObject>* ShardObject;
+		if (!ShardValue->TryGetObject(ShardObject))
+		{
+			return false;
+		}
+		FSuzieDumpShard& Shard = OutManifest.Shards.AddDefaulted_GetRef();
+		if (!(*ShardObject)->TryGetStringField(TEXT("file"), Shard.FileName) || !(*ShardObject)->TryGetStringArrayField(TEXT("packages"), Shard.PackageNames))
+		{
+			return false;
+		}
+		(*ShardObject)->TryGetStringArrayField(TEXT("imports"), Shard.Imports);
+
+		const TArray<TSharedPtr<FJsonValue>>* DependencyValues;
+		if ((*ShardObject)->TryGetArrayField(TEXT("dependencies"), DependencyValues))
+		{
+			for (const TSharedPtr<FJsonValue>& DependencyValue : *DependencyValues)
+			{
+				// Shards are generated in the order they are listed in, so a shard cannot depend on a shard that comes after it
+				const int32 DependencyIndex = (int32)DependencyValue->AsNumber();
+				if (DependencyIndex < 0 || DependencyIndex >= OutManifest.Shards.Num() - 1)
+				{
+					return false;
+				}
+				Shard.Dependencies.Add(DependencyIndex);
+			}
+		}
+	}
+	OutManifest.RebuildPackageIndex();
+	return true;
+}
+
+bool FSuzieShardManifest::Save(const FString& ShardDirectory) const
+{
+	using namespace SuzieDumpShards;
+
+	const TSharedRef<FJsonObject> ManifestObject = MakeShared<FJsonObject>();
+	ManifestObject->SetNumberField(TEXT("version"), ManifestFormatVersion);
+
+	TArray<TSharedPtr<FJsonValue>> ShardValues;
+	for (const FSuzieDumpShard& Shard : Shards)
+	{
+		const TSharedRef<FJsonObject> ShardObject = MakeShared<FJsonObject>();
+		ShardObject->SetStringField(TEXT("file"), Shard.FileName);
+
+		TArray<TSharedPtr<FJsonValue>> PackageValues;
+		for (const FString& PackageName : Shard.PackageNames)
+		{
+			PackageValues.Add(MakeShared<FJsonValueString>(PackageName));
+		}
+		ShardObject->SetArrayField(TEXT("packages"), PackageValues);
+
+		TArray<TSharedPtr<FJsonValue>> DependencyValues;
+		for (const int32 DependencyIndex : Shard.Dependencies)
+		{
+			DependencyValues.Add(MakeShared<FJsonValueNumber>(DependencyIndex));
+		}
+		ShardObject->SetArrayField(TEXT("dependencies"), DependencyValues);
+
+		TArray<TSharedPtr<FJsonValue>> ImportValues;
+		for (const FString& Import : Shard.Imports)
+		{
+			ImportValues.Add(MakeShared<FJsonValueString>(Import));
+		}
+		ShardObject->SetArrayField(TEXT("imports"), ImportValues);
+		ShardValues.Add(MakeShared<FJsonValueObject>(ShardObject));
+	}
+	ManifestObject->SetArrayField(TEXT("shards"), ShardValues);
+
+	FString ManifestContents;
+	return FJsonSerializer::Serialize(ManifestObject, TJsonWriterFactory<>::Create(&ManifestContents)) &&
+		FFileHelper::SaveStringToFile(ManifestContents, *GetManifestFilePath(ShardDirectory), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+int32 FSuzieShardManifest::FindShardForPackage(const FString& PackageName) const
+{
+	const int32* ShardIndex = ShardIndicesByPackage.Find(PackageName);
+	return ShardIndex ? *ShardIndex : INDEX_NONE;
+}
+
+void FSuzieShardManifest::RebuildPackageIndex()
+{
+	ShardIndicesByPackage.Reset();
+	for (int32 ShardIndex = 0; ShardIndex < Shards.Num(); ShardIndex++)
+	{
+		for (const FString& PackageName : Shards[ShardIndex].PackageNames)
+		{
+			ShardIndicesByPackage.Add(PackageName, ShardIndex);
+		}
+	}
+}
+
+bool FSuzieShardManifest::SplitDump(const FJsonObject& RootObject, const FString& ShardDirectory, const bool bCompressShards, FSuzieShardManifest& OutManifest)
+{
+	using namespace SuzieDumpShards;
+
+	const TSharedPtr<FJsonObject>* Objects;
+	if (!RootObject.TryGetObjectField(TEXT("objects"), Objects))
+	{
+		UE_LOG(LogSuzie, Error, TEXT("Missing 'objects' map"));
+		return false;
+	}
+
+	// Group objects by their package, keeping the order of the objects within each package
+	TArray<FString> PackageNames;
+	TMap<FString, int32> PackageIndices;
+	TArray<TArray<const TPair<FString, TSharedPtr<FJsonValue>>*>> PackageObjects;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Object : (*Objects)->Values)
+	{
+		const FString PackageName = GetPackageName(Object.Key);
+		int32& PackageIndex = PackageIndices.FindOrAdd(PackageName, INDEX_NONE);
+		if (PackageIndex == INDEX_NONE)
+		{
+			PackageIndex = PackageNames.Add(PackageName);
+			PackageObjects.AddDefaulted();
+		}
+		PackageObjects[PackageIndex].Add(&Object);
+	}
+
+	// Collect references between the packages. References to objects that are not part of the dump are native objects that always exist
+	TArray<TArray<int32>> PackageDependencies;
+	TArray<TSet<FString>> PackageImports;
+	PackageDependencies.SetNum(PackageNames.Num());
+	PackageImports.SetNum(PackageNames.Num());
+	TArray<FString> ReferencedObjectPaths;
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); PackageIndex++)
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>* Object : PackageObjects[PackageIndex])
+		{
+			const TSharedPtr<FJsonObject>* Definition;
+			if (!Object->Value->TryGetObject(Definition))
+			{
+				continue;
+			}
+			ReferencedObjectPaths.Reset();
+			CollectReferencedObjectPaths(**Definition, ReferencedObjectPaths);
+			for (const FString& ReferencedObjectPath : ReferencedObjectPaths)
+			{
+				const int32* DependencyIndex = PackageIndices.Find(GetPackageName(ReferencedObjectPath));
+				if (DependencyIndex && *DependencyIndex != PackageIndex && (*Objects)->Values.Contains(ReferencedObjectPath))
+				{
+					PackageDependencies[PackageIndex].AddUnique(*DependencyIndex);
+					PackageImports[PackageIndex].Add(ReferencedObjectPath);
+				}
+			}
+		}
+	}
+
+	// Packages referencing each other cannot be generated one after another, so they share a shard
+	FPackageComponentBuilder ComponentBuilder(PackageDependencies);
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); PackageIndex++)
+	{
+		if (ComponentBuilder.VisitIndices[PackageIndex] == INDEX_NONE)
+		{
+			ComponentBuilder.Visit(PackageIndex);
+		}
+	}
+
+	TArray<int32> PackageShardIndices;
+	PackageShardIndices.SetNum(PackageNames.Num());
+	for (int32 ShardIndex = 0; ShardIndex < ComponentBuilder.Components.Num(); ShardIndex++)
+	{
+		for (const int32 PackageIndex : ComponentBuilder.Components[ShardIndex])
+		{
+			PackageShardIndices[PackageIndex] = ShardIndex;
+		}
+	}
+
+	IFileManager::Get().MakeDirectory(*ShardDirectory, true);
+	OutManifest.Shards.Reset();
+	TSet<FString> ShardFileNames;
+	for (int32 ShardIndex = 0; ShardIndex < ComponentBuilder.Components.Num(); ShardIndex++)
+	{
+		FSuzieDumpShard& Shard = OutManifest.Shards.AddDefaulted_GetRef();
+		const TSharedRef<FJsonObject> ShardObjects = MakeShared<FJsonObject>();
+		TSet<FString> ShardImports;
+
+		for (const int32 PackageIndex : ComponentBuilder.Components[ShardIndex])
+		{
+			Shard.PackageNames.Add(PackageNames[PackageIndex]);
+			for (const TPair<FString, TSharedPtr<FJsonValue>>* Object : PackageObjects[PackageIndex])
+			{
+				ShardObjects->Values.Add(Object->Key, Object->Value);
+			}
+			for (const int32 DependencyIndex : PackageDependencies[PackageIndex])
+			{
+				if (PackageShardIndices[DependencyIndex] != ShardIndex)
+				{
+					Shard.Dependencies.AddUnique(PackageShardIndices[DependencyIndex]);
+				}
+			}
+			for (const FString& Import : PackageImports[PackageIndex])
+			{
+				if (PackageShardIndices[PackageIndices.FindChecked(GetPackageName(Import))] != ShardIndex)
+				{
+					ShardImports.Add(Import);
+				}
+			}
+		}
+		Shard.Dependencies.Sort();
+		Shard.Imports = ShardImports.Array();
+		Shard.Imports.Sort();
+
+		// Name the shard after its first package, e.g. /Script/Engine becomes Script_Engine
+		FString BaseFileName = Shard.PackageNames[0];
+		BaseFileName.RemoveFromStart(TEXT("/"));
+		BaseFileName.ReplaceCharInline(TEXT('/'), TEXT('_'));
+		BaseFileName = FPaths::MakeValidFileName(BaseFileName, TEXT('_'));
+		Shard.FileName = BaseFileName + (bCompressShards ? TEXT(".jmap.lz4") : TEXT(".jmap"));
+		for (int32 Suffix = 1; ShardFileNames.Contains(Shard.FileName); Suffix++)
+		{
+			Shard.FileName = FString::Printf(TEXT("%s_%d%s"), *BaseFileName, Suffix, bCompressShards ? TEXT(".jmap.lz4") : TEXT(".jmap"));
+		}
+		ShardFileNames.Add(Shard.FileName);
+
+		const TSharedRef<FJsonObject> ShardRootObject = MakeShared<FJsonObject>();
+		ShardRootObject->SetObjectField(TEXT("objects"), ShardObjects);
+		if (!WriteShardFile(ShardRootObject, ShardDirectory / Shard.FileName, bCompressShards))
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Failed to write shard %s"), *(ShardDirectory / Shard.FileName));
+			return false;
+		}
+	}
+	OutManifest.RebuildPackageIndex();
+	return OutManifest.Save(ShardDirectory);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/** Part of a sharded dump holding the objects of one or more packages. Packages that reference each other are always placed into the same shard */
+struct FSuzieDumpShard
+{
+	/** Name of the shard file, relative to the shard directory */
+	FString FileName;
+	/** Packages whose objects are stored in this shard */
+	TArray<FString> PackageNames;
+	/** Indices of the shards that objects of this shard reference. Dependencies always come before the shards that depend on them */
+	TArray<int32> Dependencies;
+	/** Paths of the objects in other shards that objects of this shard reference, e.g. parent classes and property types */
+	TArray<FString> Imports;
+};
+
+/**
+ * Manifest of a dump that has been split per package, stored as manifest.json in a <DumpName>.jmapshards directory next to the shard files.
+ * Shards are listed in dependency order, so generating them in order never references an object that has not been generated yet,
+ * and only one shard has to be held in memory at a time.
+ */
+class FSuzieShardManifest
+{
+public:
+	/** Extension of the directories holding the shards and the manifest */
+	static constexpr const TCHAR* ShardDirectoryExtension = TEXT(".jmapshards");
+
+	TArray<FSuzieDumpShard> Shards;
+
+	/** Returns the path of the manifest file in the given shard directory */
+	static FString GetManifestFilePath(const FString& ShardDirectory);
+	/** Loads the manifest from the given shard directory. Returns false if it is missing, malformed or lists shards out of dependency order */
+	static bool Load(const FString& ShardDirectory, FSuzieShardManifest& OutManifest);
+	/** Writes the manifest into the given shard directory */
+	bool Save(const FString& ShardDirectory) const;
+
+	/** Returns the index of the shard holding the objects of the given package, or INDEX_NONE if no shard holds them */
+	int32 FindShardForPackage(const FString& PackageName) const;
+
+	/** Splits a parsed dump into shards, and writes the shards and the manifest into the given directory. Shards are written as .jmap.lz4 if requested */
+	static bool SplitDump(const FJsonObject& RootObject, const FString& ShardDirectory, bool bCompressShards, FSuzieShardManifest& OutManifest);
+private:
+	void RebuildPackageIndex();
+
+	TMap<FString, int32> ShardIndicesByPackage;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <initializer_list>
+#include <type_traits>
+
+/**
+ * Maps dumped flag names (e.g. "CPF_Edit | CPF_Transient") to an enum bitmask in a single pass over the string.
+ * Flag names are looked up in a hash table keyed by views of the static flag name literals, so parsing does not allocate.
+ */
+template<typename EnumType>
+class TSuzieFlagNameTable
+{
+public:
+	using FUnderlyingType = std::underlying_type_t<EnumType>;
+	using FEntry = TPair<const TCHAR*, EnumType>;
+
+	TSuzieFlagNameTable(std::initializer_list<FEntry> InEntries)
+	{
+		Entries.Reserve(InEntries.size());
+		FlagBitsByName.Reserve(InEntries.size());
+		for (const FEntry& Entry : InEntries)
+		{
+			// Tables list some flags more than once, only the first entry is kept
+			if (!FlagBitsByName.Contains(Entry.Key))
+			{
+				Entries.Add(Entry);
+				FlagBitsByName.Add(Entry.Key, static_cast<FUnderlyingType>(Entry.Value));
+			}
+		}
+	}
+
+	/** Converts the flag names to the bitmask. Unknown flag names are ignored, since they are either computed or not relevant for generation */
+	EnumType Parse(const FStringView Flags) const
+	{
+		FUnderlyingType Result{};
+		const TCHAR* const End = Flags.GetData() + Flags.Len();
+		const TCHAR* TokenStart = Flags.GetData();
+		while (TokenStart < End)
+		{
+			const TCHAR* TokenEnd = TokenStart;
+			while (TokenEnd < End && *TokenEnd != TEXT('|'))
+			{
+				TokenEnd++;
+			}
+			const FStringView FlagName = FStringView(TokenStart, UE_PTRDIFF_TO_INT32(TokenEnd - TokenStart)).TrimStartAndEnd();
+			if (const FUnderlyingType* FlagBits = FlagBitsByName.Find(FlagName))
+			{
+				Result |= *FlagBits;
+			}
+			TokenStart = TokenEnd + 1;
+		}
+		return static_cast<EnumType>(Result);
+	}
+
+	/** Returns flag names and values in the order they have been declared in */
+	TConstArrayView<FEntry> GetEntries() const { return Entries; }
+private:
+	TArray<FEntry> Entries;
+	TMap<FStringView, FUnderlyingType> FlagBitsByName;
+};
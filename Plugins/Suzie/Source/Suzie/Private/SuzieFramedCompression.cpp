@@ -0,0 +1,118 @@
+#include "SuzieFramedCompression.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Compression.h"
+#include <atomic>
+
+namespace SuzieFramedCompression
+{
+	// "SZLF" in little endian
+	constexpr uint32 ArchiveMagic = 0x464C5A53;
+	// Must be bumped whenever the layout of the archive changes
+	constexpr uint32 ArchiveFormatVersion = 1;
+
+	struct FArchiveHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 FrameSize;
+		uint32 NumFrames;
+		int64 UncompressedSize;
+	};
+}
+
+bool FSuzieFramedCompression::CompressMemory(const TConstArrayView<uint8> UncompressedData, TArray<uint8>& OutCompressedData, const int32 FrameSize)
+{
+	using namespace SuzieFramedCompression;
+	check(FrameSize > 0);
+
+	const int32 NumFrames = FMath::DivideAndRoundUp(UncompressedData.Num(), FrameSize);
+	const int32 MaxCompressedFrameSize = FCompression::CompressMemoryBound(NAME_LZ4, FrameSize);
+
+	// Compress every frame into its own worst case sized slot first, the slots are packed together once all frames are compressed
+	TArray<uint8> FrameBuffer;
+	FrameBuffer.SetNumUninitialized(NumFrames * MaxCompressedFrameSize);
+	TArray<uint32> CompressedFrameSizes;
+	CompressedFrameSizes.SetNumZeroed(NumFrames);
+	std::atomic<bool> bFailed{false};
+
+	ParallelFor(NumFrames, [&](const int32 FrameIndex)
+	{
+		const int32 FrameOffset = FrameIndex * FrameSize;
+		const int32 UncompressedFrameSize = FMath::Min(FrameSize, UncompressedData.Num() - FrameOffset);
+		int32 CompressedFrameSize = MaxCompressedFrameSize;
+		if (!FCompression::CompressMemory(NAME_LZ4, FrameBuffer.GetData() + FrameIndex * MaxCompressedFrameSize, CompressedFrameSize, UncompressedData.GetData() + FrameOffset, UncompressedFrameSize))
+		{
+			bFailed = true;
+			return;
+		}
+		CompressedFrameSizes[FrameIndex] = CompressedFrameSize;
+	});
+	if (bFailed)
+	{
+		return false;
+	}
+
+	const FArchiveHeader Header{ArchiveMagic, ArchiveFormatVersion, (uint32)FrameSize, (uint32)NumFrames, UncompressedData.Num()};
+	OutCompressedData.Reset();
+	OutCompressedData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	OutCompressedData.Append(reinterpret_cast<const uint8*>(CompressedFrameSizes.GetData()), CompressedFrameSizes.Num() * sizeof(uint32));
+	for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+	{
+		OutCompressedData.Append(FrameBuffer.GetData() + FrameIndex * MaxCompressedFrameSize, CompressedFrameSizes[FrameIndex]);
+	}
+	return true;
+}
+
+bool FSuzieFramedCompression::DecompressMemory(const TConstArrayView<uint8> CompressedData, TArray<uint8>& OutDecompressedData)
+{
+	using namespace SuzieFramedCompression;
+
+	FArchiveHeader Header;
+	if (CompressedData.Num() < sizeof(Header))
+	{
+		return false;
+	}
+	FMemory::Memcpy(&Header, CompressedData.GetData(), sizeof(Header));
+	if (Header.Magic != ArchiveMagic || Header.Version != ArchiveFormatVersion || Header.FrameSize == 0 || Header.UncompressedSize < 0 || Header.UncompressedSize >= MAX_int32 ||
+		FMath::DivideAndRoundUp<int64>(Header.UncompressedSize, Header.FrameSize) != Header.NumFrames)
+	{
+		return false;
+	}
+
+	// Resolve the offset of every frame up front so that the frames can be decompressed independently
+	const int64 FrameTableOffset = sizeof(Header);
+	const int64 FrameDataOffset = FrameTableOffset + (int64)Header.NumFrames * sizeof(uint32);
+	if (CompressedData.Num() < FrameDataOffset)
+	{
+		return false;
+	}
+	TArray<int64> FrameOffsets;
+	FrameOffsets.SetNumUninitialized(Header.NumFrames + 1);
+	FrameOffsets[0] = FrameDataOffset;
+	for (uint32 FrameIndex = 0; FrameIndex < Header.NumFrames; FrameIndex++)
+	{
+		uint32 CompressedFrameSize;
+		FMemory::Memcpy(&CompressedFrameSize, CompressedData.GetData() + FrameTableOffset + FrameIndex * sizeof(uint32), sizeof(uint32));
+		FrameOffsets[FrameIndex + 1] = FrameOffsets[FrameIndex] + CompressedFrameSize;
+	}
+	if (FrameOffsets.Last() != CompressedData.Num())
+	{
+		return false;
+	}
+
+	OutDecompressedData.Reset();
+	OutDecompressedData.SetNumUninitialized((int32)Header.UncompressedSize);
+	std::atomic<bool> bFailed{false};
+
+	ParallelFor(Header.NumFrames, [&](const int32 FrameIndex)
+	{
+		const int64 FrameOffset = (int64)FrameIndex * Header.FrameSize;
+		const int32 UncompressedFrameSize = (int32)FMath::Min<int64>(Header.FrameSize, Header.UncompressedSize - FrameOffset);
+		const int32 CompressedFrameSize = (int32)(FrameOffsets[FrameIndex + 1] - FrameOffsets[FrameIndex]);
+		if (!FCompression::UncompressMemory(NAME_LZ4, OutDecompressedData.GetData() + FrameOffset, UncompressedFrameSize, CompressedData.GetData() + FrameOffsets[FrameIndex], CompressedFrameSize))
+		{
+			bFailed = true;
+		}
+	});
+	return !bFailed;
+}
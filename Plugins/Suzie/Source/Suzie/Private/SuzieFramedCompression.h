@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Multi-frame LZ4 archive used by .jmap.lz4 dumps.
+ * The data is split into frames of a fixed uncompressed size that are compressed independently, so all frames can be decompressed in parallel.
+ * The archive starts with a header holding the frame size, the number of frames and the total uncompressed size,
+ * followed by a table of compressed frame sizes and the compressed frames themselves.
+ */
+class FSuzieFramedCompression
+{
+public:
+	/** Default uncompressed size of a single frame. Small enough to keep all workers busy, large enough for the compression ratio to not suffer */
+	static constexpr int32 DefaultFrameSize = 4 * 1024 * 1024;
+
+	/** Compresses the data into a framed archive, compressing the frames in parallel */
+	static bool CompressMemory(TConstArrayView<uint8> UncompressedData, TArray<uint8>& OutCompressedData, int32 FrameSize = DefaultFrameSize);
+	/** Decompresses a framed archive, decompressing the frames in parallel straight into their final location in the output buffer */
+	static bool DecompressMemory(TConstArrayView<uint8> CompressedData, TArray<uint8>& OutDecompressedData);
+};
@@ -0,0 +1,133 @@
+#include "SuzieGenerationCommandlet.h"
+#include "SuziePlugin.h"
+#include "SuzieDumpCache.h"
+#include "SuzieGenerationStats.h"
+#include "SuzieSyntheticDump.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+USuzieGenerationCommandlet::USuzieGenerationCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 USuzieGenerationCommandlet::Main(const FString& Params)
+{
+	FSuzieSyntheticDumpSettings SyntheticDumpSettings;
+	FParse::Value(*Params, TEXT("Classes="), SyntheticDumpSettings.NumClasses);
+	FParse::Value(*Params, TEXT("Properties="), SyntheticDumpSettings.NumPropertiesPerClass);
+	FParse::Value(*Params, TEXT("Subobjects="), SyntheticDumpSettings.NumSubobjectsPerClass);
+	FParse::Value(*Params, TEXT("Depth="), SyntheticDumpSettings.InheritanceDepth);
+	FParse::Bool(*Params, TEXT("ChildClassSubobject="), SyntheticDumpSettings.bChildClassSubobject);
+
+	// Only write the synthetic dump without generating anything from it
+	FString SyntheticDumpFilePath;
+	if (FParse::Value(*Params, TEXT("WriteSyntheticDump="), SyntheticDumpFilePath))
+	{
+		if (!FSuzieSyntheticDump::GenerateToFile(SyntheticDumpSettings, SyntheticDumpFilePath))
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Failed to write synthetic dump to %s"), *SyntheticDumpFilePath);
+			return 1;
+		}
+		UE_LOG(LogSuzie, Display, TEXT("Wrote synthetic dump with %d classes to %s"), SyntheticDumpSettings.NumClasses, *SyntheticDumpFilePath);
+		return 0;
+	}
+
+	FSuzieGenerationStats::WarnIfUnoptimized(TEXT("Generation benchmark"));
+	const IConsoleVariable* LazyClassGenerationVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("Suzie.LazyClassGeneration"));
+	if (LazyClassGenerationVariable && LazyClassGenerationVariable->GetBool())
+	{
+		UE_LOG(LogSuzie, Warning, TEXT("Lazy class generation is enabled, only parsing and indexing of the dumps will be measured"));
+	}
+	if (!FParse::Param(FCommandLine::Get(), TEXT("SuzieNoStartupGeneration")))
+	{
+		UE_LOG(LogSuzie, Warning, TEXT("Classes of the project have been generated at startup. Pass -SuzieNoStartupGeneration to exclude them from the measurements"));
+	}
+
+	int32 Iterations = 1;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(Iterations, 1);
+
+	const bool bSynthetic = FParse::Param(*Params, TEXT("Synthetic"));
+	const bool bUseCache = FParse::Param(*Params, TEXT("UseCache"));
+	FString Directory = FSuziePluginModule::GetJsonClassDefinitionDirectory();
+	if (!bSynthetic)
+	{
+		FParse::Value(*Params, TEXT("Directory="), Directory);
+		if (!IFileManager::Get().DirectoryExists(*Directory))
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Class definition directory %s does not exist"), *Directory);
+			return 1;
+		}
+		// Generated objects cannot be destroyed, so generating the same dump again finds the existing objects
+		if (Iterations > 1)
+		{
+			UE_LOG(LogSuzie, Warning, TEXT("Objects are only generated on the first iteration, later iterations measure parsing and indexing of the dumps. Use -Synthetic to measure generation on every iteration"));
+		}
+	}
+
+	FSuziePluginModule& SuziePluginModule = FModuleManager::LoadModuleChecked<FSuziePluginModule>(TEXT("Suzie"));
+	const FSuzieGenerationStats& GenerationStats = FSuzieGenerationStats::Get();
+
+	TArray<double> IterationTimes;
+	TArray<double> PhaseTimes[(int32)ESuzieGenerationPhase::Num];
+	for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		FString IterationDirectory = Directory;
+		if (bSynthetic)
+		{
+			// Every iteration uses its own package so that its objects do not exist yet and have to be generated
+			SyntheticDumpSettings.PackageName = FString::Printf(TEXT("/Script/SuzieSynthetic%d"), Iteration);
+			IterationDirectory = FPaths::ProjectSavedDir() / TEXT("Suzie") / TEXT("SyntheticDump") / FString::Printf(TEXT("Iteration%d"), Iteration);
+			IFileManager::Get().DeleteDirectory(*IterationDirectory, false, true);
+
+			const FString DumpFilePath = IterationDirectory / FString::Printf(TEXT("SuzieSynthetic%d.jmap"), Iteration);
+			if (!FSuzieSyntheticDump::GenerateToFile(SyntheticDumpSettings, DumpFilePath))
+			{
+				UE_LOG(LogSuzie, Error, TEXT("Failed to write synthetic dump to %s"), *DumpFilePath);
+				return 1;
+			}
+			// Dumps with the same settings are identical between runs, so the cache of the previous run would be used otherwise
+			if (!bUseCache)
+			{
+				IFileManager::Get().Delete(*FSuzieDumpCache::GetCacheFilePath(DumpFilePath), false, true, true);
+			}
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		SuziePluginModule.ProcessAllJsonClassDefinitions(IterationDirectory);
+		IterationTimes.Add(FPlatformTime::Seconds() - StartTime);
+
+		for (int32 PhaseIndex = 0; PhaseIndex < (int32)ESuzieGenerationPhase::Num; PhaseIndex++)
+		{
+			PhaseTimes[PhaseIndex].Add(GenerationStats.GetPhaseSeconds((ESuzieGenerationPhase)PhaseIndex));
+		}
+		UE_LOG(LogSuzie, Display, TEXT("Iteration %d/%d: %.3f seconds, %lld classes, %lld properties"), Iteration + 1, Iterations, IterationTimes.Last(),
+			GenerationStats.GetCounter(ESuzieGenerationCounter::Classes), GenerationStats.GetCounter(ESuzieGenerationCounter::Properties));
+	}
+
+	// Average, minimum and maximum over all iterations. The first iteration also includes one-time costs, e.g. loading the parent classes
+	const auto LogTimes = [](const TCHAR* Name, const TArray<double>& Times)
+	{
+		double TotalTime = 0.0;
+		for (const double Time : Times)
+		{
+			TotalTime += Time;
+		}
+		if (TotalTime > 0.0)
+		{
+			UE_LOG(LogSuzie, Display, TEXT("  %-24s avg %9.3f s, min %9.3f s, max %9.3f s"), Name, TotalTime / Times.Num(), FMath::Min(Times), FMath::Max(Times));
+		}
+	};
+	UE_LOG(LogSuzie, Display, TEXT("Suzie generation benchmark over %d iterations:"), Iterations);
+	LogTimes(TEXT("Total"), IterationTimes);
+	for (int32 PhaseIndex = 0; PhaseIndex < (int32)ESuzieGenerationPhase::Num; PhaseIndex++)
+	{
+		LogTimes(FSuzieGenerationStats::GetPhaseName((ESuzieGenerationPhase)PhaseIndex), PhaseTimes[PhaseIndex]);
+	}
+	return 0;
+}
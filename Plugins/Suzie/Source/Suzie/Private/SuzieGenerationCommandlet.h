@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SuzieGenerationCommandlet.generated.h"
+
+/**
+ * Runs class generation headlessly and reports per-phase timings, to measure generation throughput without launching the editor UI.
+ *
+ * Generate classes from a directory of dumps:
+ *   UnrealEditor-Cmd <Project> -run=SuzieGeneration -SuzieNoStartupGeneration -Directory=<Path> [-Iterations=N]
+ * Generate classes from synthetic dumps:
+ *   UnrealEditor-Cmd <Project> -run=SuzieGeneration -SuzieNoStartupGeneration -Synthetic [-Classes=N] [-Properties=N] [-Subobjects=N] [-Depth=N] [-ChildClassSubobject=true|false] [-Iterations=N]
+ * Only write a synthetic dump, e.g. to use it as a project dump:
+ *   UnrealEditor-Cmd <Project> -run=SuzieGeneration -WriteSyntheticDump=<FilePath> [-Classes=N] [-Properties=N] [-Subobjects=N] [-Depth=N] [-ChildClassSubobject=true|false]
+ */
+UCLASS()
+class USuzieGenerationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	USuzieGenerationCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,186 @@
+#include "SuzieGenerationStats.h"
+#include "SuziePlugin.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+
+/** Innermost phase timer of the current thread */
+static thread_local FSuzieScopedPhaseTimer* ActivePhaseTimer = nullptr;
+
+FSuzieGenerationStats& FSuzieGenerationStats::Get()
+{
+	static FSuzieGenerationStats Instance;
+	return Instance;
+}
+
+void FSuzieGenerationStats::BeginRun()
+{
+	for (std::atomic<uint64>& Cycles : PhaseCycles)
+	{
+		Cycles.store(0, std::memory_order_relaxed);
+	}
+	for (std::atomic<int64>& Counter : Counters)
+	{
+		Counter.store(0, std::memory_order_relaxed);
+	}
+	PeakJsonBytes.store(LiveJsonBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	RunStartTime = FPlatformTime::Seconds();
+	RunStartUsedPhysicalMemory = FPlatformMemory::GetStats().UsedPhysical;
+}
+
+void FSuzieGenerationStats::AddPhaseCycles(const ESuzieGenerationPhase Phase, const uint64 Cycles)
+{
+	PhaseCycles[(int32)Phase].fetch_add(Cycles, std::memory_order_relaxed);
+}
+
+void FSuzieGenerationStats::IncrementCounter(const ESuzieGenerationCounter Counter, const int64 Amount)
+{
+	Counters[(int32)Counter].fetch_add(Amount, std::memory_order_relaxed);
+}
+
+int64 FSuzieGenerationStats::GetCounter(const ESuzieGenerationCounter Counter) const
+{
+	return Counters[(int32)Counter].load(std::memory_order_relaxed);
+}
+
+void FSuzieGenerationStats::AddLiveJsonBytes(const int64 Delta)
+{
+	const int64 NewLiveJsonBytes = LiveJsonBytes.fetch_add(Delta, std::memory_order_relaxed) + Delta;
+	int64 CurrentPeakJsonBytes = PeakJsonBytes.load(std::memory_order_relaxed);
+	while (NewLiveJsonBytes > CurrentPeakJsonBytes && !PeakJsonBytes.compare_exchange_weak(CurrentPeakJsonBytes, NewLiveJsonBytes, std::memory_order_relaxed))
+	{
+	}
+}
+
+double FSuzieGenerationStats::GetPhaseSeconds(const ESuzieGenerationPhase Phase) const
+{
+	return FPlatformTime::ToSeconds64(PhaseCycles[(int32)Phase].load(std::memory_order_relaxed));
+}
+
+void FSuzieGenerationStats::LogSummary(const FString& RunName) const
+{
+	const double WallTime = FPlatformTime::Seconds() - RunStartTime;
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	const double UsedMemoryDeltaMB = ((double)MemoryStats.UsedPhysical - (double)RunStartUsedPhysicalMemory) / (1024.0 * 1024.0);
+
+	UE_LOG(LogSuzie, Display, TEXT("%s finished in %.2f seconds. Used memory changed by %.1f MB (peak %.1f MB)"),
+		*RunName, WallTime, UsedMemoryDeltaMB, MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+
+	// Phases that run on worker threads are summed over all threads, so the total can exceed the wall time
+	for (int32 PhaseIndex = 0; PhaseIndex < (int32)ESuzieGenerationPhase::Num; PhaseIndex++)
+	{
+		const double PhaseSeconds = GetPhaseSeconds((ESuzieGenerationPhase)PhaseIndex);
+		if (PhaseSeconds > 0.0)
+		{
+			UE_LOG(LogSuzie, Display, TEXT("  %-24s %9.3f s"), GetPhaseName((ESuzieGenerationPhase)PhaseIndex), PhaseSeconds);
+		}
+	}
+	for (int32 CounterIndex = 0; CounterIndex < (int32)ESuzieGenerationCounter::Num; CounterIndex++)
+	{
+		const int64 CounterValue = GetCounter((ESuzieGenerationCounter)CounterIndex);
+		if (CounterValue != 0)
+		{
+			UE_LOG(LogSuzie, Display, TEXT("  %-24s %9lld"), GetCounterName((ESuzieGenerationCounter)CounterIndex), CounterValue);
+		}
+	}
+
+	// Parsed documents are several times the size of the dump, and are only retained for lazy class generation
+	const int64 PeakJsonBytesValue = PeakJsonBytes.load(std::memory_order_relaxed);
+	if (PeakJsonBytesValue > 0)
+	{
+		UE_LOG(LogSuzie, Display, TEXT("  Parsed JSON: peak %.1f MB, retained %.1f MB"), PeakJsonBytesValue / (1024.0 * 1024.0), LiveJsonBytes.load(std::memory_order_relaxed) / (1024.0 * 1024.0));
+	}
+
+	// Archetypes are a copy of every CDO, so report their cost per class to compare the archetype creation strategies
+	const int64 NumArchetypes = GetCounter(ESuzieGenerationCounter::Archetypes);
+	if (NumArchetypes > 0)
+	{
+		UE_LOG(LogSuzie, Display, TEXT("  Archetype cost per class: %.1f us, %.1f KB"), GetPhaseSeconds(ESuzieGenerationPhase::ArchetypeCreation) * 1e6 / NumArchetypes,
+			GetCounter(ESuzieGenerationCounter::ArchetypeBytes) / 1024.0 / NumArchetypes);
+	}
+	const int64 NumDeferredArchetypes = GetCounter(ESuzieGenerationCounter::DeferredArchetypes);
+	if (NumDeferredArchetypes > 0)
+	{
+		UE_LOG(LogSuzie, Display, TEXT("  Archetypes deferred until the first instance: %lld, saving %.1f KB per class"), NumDeferredArchetypes,
+			GetCounter(ESuzieGenerationCounter::DeferredArchetypeBytes) / 1024.0 / NumDeferredArchetypes);
+	}
+}
+
+void FSuzieGenerationStats::WarnIfUnoptimized(const TCHAR* MeasurementName)
+{
+#if SUZIE_DEBUG_BUILD || UE_BUILD_DEBUG
+	UE_LOG(LogSuzie, Warning, TEXT("%s is running in a build without optimization, its timings are not representative. Build the Development configuration with bDebugBuild unset in Suzie.Build.cs"), MeasurementName);
+#endif
+}
+
+const TCHAR* FSuzieGenerationStats::GetPhaseName(const ESuzieGenerationPhase Phase)
+{
+	switch (Phase)
+	{
+	case ESuzieGenerationPhase::FileRead: return TEXT("File read");
+	case ESuzieGenerationPhase::CacheLoad: return TEXT("Cache load");
+	case ESuzieGenerationPhase::CacheSave: return TEXT("Cache save");
+	case ESuzieGenerationPhase::Decompression: return TEXT("Decompression");
+	case ESuzieGenerationPhase::JsonParsing: return TEXT("JSON parsing");
+	case ESuzieGenerationPhase::Indexing: return TEXT("Indexing");
+	case ESuzieGenerationPhase::ClassCreation: return TEXT("Class creation");
+	case ESuzieGenerationPhase::StructCreation: return TEXT("Struct creation");
+	case ESuzieGenerationPhase::EnumCreation: return TEXT("Enum creation");
+	case ESuzieGenerationPhase::FunctionCreation: return TEXT("Function creation");
+	case ESuzieGenerationPhase::PropertyCreation: return TEXT("Property creation");
+	case ESuzieGenerationPhase::StaticLink: return TEXT("Linking");
+	case ESuzieGenerationPhase::DefaultObjectCreation: return TEXT("CDO creation");
+	case ESuzieGenerationPhase::PropertyDeserialization: return TEXT("Property values");
+	case ESuzieGenerationPhase::ArchetypeCreation: return TEXT("Archetype creation");
+	default: return TEXT("Unknown");
+	}
+}
+
+const TCHAR* FSuzieGenerationStats::GetCounterName(const ESuzieGenerationCounter Counter)
+{
+	switch (Counter)
+	{
+	case ESuzieGenerationCounter::FilesLoaded: return TEXT("Files loaded");
+	case ESuzieGenerationCounter::CacheHits: return TEXT("Cache hits");
+	case ESuzieGenerationCounter::BytesRead: return TEXT("Bytes read");
+	case ESuzieGenerationCounter::BytesDecompressed: return TEXT("Bytes decompressed");
+	case ESuzieGenerationCounter::Classes: return TEXT("Classes");
+	case ESuzieGenerationCounter::ScriptStructs: return TEXT("Structs");
+	case ESuzieGenerationCounter::Enums: return TEXT("Enums");
+	case ESuzieGenerationCounter::Functions: return TEXT("Functions");
+	case ESuzieGenerationCounter::Properties: return TEXT("Properties");
+	case ESuzieGenerationCounter::PropertyPaddingBytes: return TEXT("Property padding bytes");
+	case ESuzieGenerationCounter::InternedNames: return TEXT("Interned names");
+	case ESuzieGenerationCounter::DefaultObjects: return TEXT("Default objects");
+	case ESuzieGenerationCounter::Archetypes: return TEXT("Archetypes");
+	case ESuzieGenerationCounter::ArchetypeBytes: return TEXT("Archetype bytes");
+	case ESuzieGenerationCounter::DeferredArchetypes: return TEXT("Deferred archetypes");
+	case ESuzieGenerationCounter::DeferredArchetypeBytes: return TEXT("Deferred archetype bytes");
+	default: return TEXT("Unknown");
+	}
+}
+
+FSuzieScopedPhaseTimer::FSuzieScopedPhaseTimer(const ESuzieGenerationPhase InPhase) :
+	Phase(InPhase),
+	ParentTimer(ActivePhaseTimer)
+{
+	StartCycles = FPlatformTime::Cycles64();
+
+	// Stop the clock of the enclosing phase, it will be resumed when this phase ends
+	if (ParentTimer)
+	{
+		FSuzieGenerationStats::Get().AddPhaseCycles(ParentTimer->Phase, StartCycles - ParentTimer->StartCycles);
+	}
+	ActivePhaseTimer = this;
+}
+
+FSuzieScopedPhaseTimer::~FSuzieScopedPhaseTimer()
+{
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+	FSuzieGenerationStats::Get().AddPhaseCycles(Phase, EndCycles - StartCycles);
+
+	if (ParentTimer)
+	{
+		ParentTimer->StartCycles = EndCycles;
+	}
+	ActivePhaseTimer = ParentTimer;
+}
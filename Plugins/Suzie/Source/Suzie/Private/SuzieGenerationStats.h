@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
+
+/** Set by Suzie.Build.cs when the module is compiled without optimization */
+#ifndef SUZIE_DEBUG_BUILD
+#define SUZIE_DEBUG_BUILD 0
+#endif
+
+/** Phases of class generation. Time spent in each phase is exclusive, e.g. time spent creating a parent class is not counted towards the child class */
+enum class ESuzieGenerationPhase : uint8
+{
+	FileRead,
+	CacheLoad,
+	CacheSave,
+	Decompression,
+	JsonParsing,
+	Indexing,
+	ClassCreation,
+	StructCreation,
+	EnumCreation,
+	FunctionCreation,
+	PropertyCreation,
+	StaticLink,
+	DefaultObjectCreation,
+	PropertyDeserialization,
+	ArchetypeCreation,
+	Num
+};
+
+enum class ESuzieGenerationCounter : uint8
+{
+	FilesLoaded,
+	CacheHits,
+	BytesRead,
+	BytesDecompressed,
+	Classes,
+	ScriptStructs,
+	Enums,
+	Functions,
+	Properties,
+	PropertyPaddingBytes,
+	InternedNames,
+	DefaultObjects,
+	Archetypes,
+	ArchetypeBytes,
+	DeferredArchetypes,
+	DeferredArchetypeBytes,
+	Num
+};
+
+/**
+ * Accumulates time and counters of a generation run and logs a summary at the end of it.
+ * Phases running on worker threads are accumulated as well, so the time of the parallel phases is the sum over all threads.
+ */
+class FSuzieGenerationStats
+{
+public:
+	static FSuzieGenerationStats& Get();
+
+	/** Starts a new run, resetting all accumulated values */
+	void BeginRun();
+	/** Logs time spent in each phase, counters and the memory used by the run */
+	void LogSummary(const FString& RunName) const;
+
+	void AddPhaseCycles(ESuzieGenerationPhase Phase, uint64 Cycles);
+	void IncrementCounter(ESuzieGenerationCounter Counter, int64 Amount = 1);
+	int64 GetCounter(ESuzieGenerationCounter Counter) const;
+	double GetPhaseSeconds(ESuzieGenerationPhase Phase) const;
+	/** Tracks the size of the parsed JSON documents that are currently alive. The peak is reset at the start of every run */
+	void AddLiveJsonBytes(int64 Delta);
+
+	/** Warns that the measurements are not representative if this module or the engine has been compiled without optimization */
+	static void WarnIfUnoptimized(const TCHAR* MeasurementName);
+
+	static const TCHAR* GetPhaseName(ESuzieGenerationPhase Phase);
+	static const TCHAR* GetCounterName(ESuzieGenerationCounter Counter);
+private:
+	std::atomic<uint64> PhaseCycles[(int32)ESuzieGenerationPhase::Num]{};
+	std::atomic<int64> Counters[(int32)ESuzieGenerationCounter::Num]{};
+	std::atomic<int64> LiveJsonBytes{};
+	std::atomic<int64> PeakJsonBytes{};
+	double RunStartTime{};
+	uint64 RunStartUsedPhysicalMemory{};
+};
+
+/** Measures exclusive time of a phase. Pauses the enclosing phase on the same thread while this one is active */
+class FSuzieScopedPhaseTimer
+{
+public:
+	explicit FSuzieScopedPhaseTimer(ESuzieGenerationPhase InPhase);
+	~FSuzieScopedPhaseTimer();
+
+	UE_NONCOPYABLE(FSuzieScopedPhaseTimer);
+private:
+	ESuzieGenerationPhase Phase;
+	uint64 StartCycles;
+	FSuzieScopedPhaseTimer* ParentTimer;
+};
+
+/** Instruments the rest of the scope as the given generation phase, both for Unreal Insights and for the summary log */
+#define SUZIE_SCOPED_PHASE(PhaseName) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Suzie_##PhaseName); \
+	FSuzieScopedPhaseTimer ANONYMOUS_VARIABLE(SuziePhaseTimer_)(ESuzieGenerationPhase::PhaseName)
+
+#define SUZIE_INCREMENT_COUNTER(CounterName, ...) \
+	FSuzieGenerationStats::Get().IncrementCounter(ESuzieGenerationCounter::CounterName, ##__VA_ARGS__)
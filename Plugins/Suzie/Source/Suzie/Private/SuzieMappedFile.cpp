@@ -0,0 +1,39 @@
+#include "SuzieMappedFile.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+TUniquePtr<FSuzieMappedFile> FSuzieMappedFile::Open(const FString& FilePath)
+{
+	TUniquePtr<FSuzieMappedFile> MappedFile(new FSuzieMappedFile());
+
+	// Attempt to map the file first. Empty files cannot be mapped, and not all platforms support mapping files
+	MappedFile->MappedFileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (MappedFile->MappedFileHandle.IsValid() && MappedFile->MappedFileHandle->GetFileSize() > 0)
+	{
+		MappedFile->MappedFileRegion.Reset(MappedFile->MappedFileHandle->MapRegion(0, MappedFile->MappedFileHandle->GetFileSize()));
+		if (MappedFile->MappedFileRegion.IsValid())
+		{
+			MappedFile->Data = MappedFile->MappedFileRegion->GetMappedPtr();
+			MappedFile->Size = MappedFile->MappedFileRegion->GetMappedSize();
+			return MappedFile;
+		}
+	}
+	MappedFile->MappedFileHandle.Reset();
+
+	// Fall back to reading the entire file into memory
+	if (!FFileHelper::LoadFileToArray(MappedFile->FileContents, *FilePath))
+	{
+		return nullptr;
+	}
+	MappedFile->Data = MappedFile->FileContents.GetData();
+	MappedFile->Size = MappedFile->FileContents.Num();
+	return MappedFile;
+}
+
+FSuzieMappedFile::~FSuzieMappedFile()
+{
+	// Region must be unmapped before the file handle is closed
+	MappedFileRegion.Reset();
+	MappedFileHandle.Reset();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** Read-only view of the contents of a file. Memory maps the file when the platform supports it, and falls back to reading it into memory otherwise */
+class FSuzieMappedFile
+{
+public:
+	/** Opens the file at the given path. Returns null if the file does not exist or could not be read */
+	static TUniquePtr<FSuzieMappedFile> Open(const FString& FilePath);
+
+	~FSuzieMappedFile();
+
+	const uint8* GetData() const { return Data; }
+	int64 GetSize() const { return Size; }
+	bool IsMapped() const { return MappedFileRegion.IsValid(); }
+private:
+	FSuzieMappedFile() = default;
+
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+	TUniquePtr<IMappedFileRegion> MappedFileRegion;
+	TArray64<uint8> FileContents;
+	const uint8* Data{};
+	int64 Size{};
+};
@@ -0,0 +1,64 @@
+#include "SuzieNameTable.h"
+#include "SuziePlugin.h"
+#include "SuzieGenerationStats.h"
+
+namespace SuzieNameTable
+{
+	/** Number of characters in a single chunk of the string storage. Longer strings get a chunk of their own */
+	static constexpr int32 StringStorageChunkSize = 16 * 1024;
+}
+
+FName FSuzieNameTable::FindOrAdd(const FStringView String)
+{
+	const uint32 Hash = TCaseSensitiveKeyFuncs<FName>::GetKeyHash(String);
+	if (const FName* ExistingName = Names.FindByHash(Hash, String))
+	{
+		return *ExistingName;
+	}
+	const FName NewName(String.Len(), String.GetData());
+	Names.AddByHash(Hash, StoreString(String), NewName);
+	SUZIE_INCREMENT_COUNTER(InternedNames);
+	return NewName;
+}
+
+FSuzieObjectPathNames FSuzieNameTable::SplitObjectPath(const FStringView ObjectPath)
+{
+	const uint32 Hash = TCaseSensitiveKeyFuncs<FSuzieObjectPathNames>::GetKeyHash(ObjectPath);
+	if (const FSuzieObjectPathNames* ExistingPathNames = ObjectPaths.FindByHash(Hash, ObjectPath))
+	{
+		return *ExistingPathNames;
+	}
+
+	FStringView OuterPath;
+	FStringView ObjectName;
+	FSuziePluginModule::ParseObjectPath(ObjectPath, OuterPath, ObjectName);
+
+	FSuzieObjectPathNames PathNames;
+	PathNames.OuterPath = FindOrAdd(OuterPath);
+	PathNames.ObjectName = FindOrAdd(ObjectName);
+	int32 SeparatorIndex;
+	PathNames.bOuterIsPackage = !OuterPath.IsEmpty() && !OuterPath.FindChar(TEXT('.'), SeparatorIndex) && !OuterPath.FindChar(TEXT(':'), SeparatorIndex);
+
+	ObjectPaths.AddByHash(Hash, StoreString(ObjectPath), PathNames);
+	return PathNames;
+}
+
+void FSuzieNameTable::Reset()
+{
+	Names.Empty();
+	ObjectPaths.Empty();
+	StringStorage.Empty();
+}
+
+FStringView FSuzieNameTable::StoreString(const FStringView String)
+{
+	// Chunks are never reallocated once created, only the array of chunks is, which does not move the characters
+	if (StringStorage.IsEmpty() || StringStorage.Last().Num() + String.Len() > StringStorage.Last().Max())
+	{
+		StringStorage.AddDefaulted_GetRef().Reserve(FMath::Max(SuzieNameTable::StringStorageChunkSize, String.Len()));
+	}
+	TArray<TCHAR>& Chunk = StringStorage.Last();
+	const int32 StringOffset = Chunk.Num();
+	Chunk.Append(String.GetData(), String.Len());
+	return FStringView(Chunk.GetData() + StringOffset, String.Len());
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Hash/CityHash.h"
+
+/** Object path split into the path of its outer and its name, see FSuziePluginModule::ParseObjectPath */
+struct FSuzieObjectPathNames
+{
+	FName OuterPath;
+	FName ObjectName;
+	/** True if the outer is a package, which means the object can be found by name without resolving the outer path first */
+	bool bOuterIsPackage{};
+};
+
+/**
+ * Interns strings of a dump as names. Dumps repeat the same property names, property types and object paths thousands of times,
+ * so cached strings do not have to be hashed into the global name table and split into their parts again.
+ * Lookups are case sensitive, since names preserve the case they have been created with in the editor.
+ * Not thread safe, every generation context has its own table.
+ */
+class FSuzieNameTable
+{
+public:
+	/** Returns the name for the string, creating it on the first lookup */
+	FName FindOrAdd(FStringView String);
+	/** Splits the object path into the outer path and the object name. Should only be used for paths that are looked up repeatedly, since every path is cached */
+	FSuzieObjectPathNames SplitObjectPath(FStringView ObjectPath);
+	/** Releases all cached names and strings */
+	void Reset();
+private:
+	/** Copies the string into the string storage, so that the views used as keys remain valid */
+	FStringView StoreString(FStringView String);
+
+	template<typename ValueType>
+	struct TCaseSensitiveKeyFuncs : TDefaultMapKeyFuncs<FStringView, ValueType, false>
+	{
+		static bool Matches(const FStringView A, const FStringView B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FStringView Key) { return CityHash32(reinterpret_cast<const char*>(Key.GetData()), Key.Len() * sizeof(TCHAR)); }
+	};
+
+	TMap<FStringView, FName, FDefaultSetAllocator, TCaseSensitiveKeyFuncs<FName>> Names;
+	TMap<FStringView, FSuzieObjectPathNames, FDefaultSetAllocator, TCaseSensitiveKeyFuncs<FSuzieObjectPathNames>> ObjectPaths;
+	/** Strings are appended to fixed size chunks, so that the strings do not move when new ones are added */
+	TArray<TArray<TCHAR>> StringStorage;
+};
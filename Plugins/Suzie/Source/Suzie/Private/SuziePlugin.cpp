@@ -15,9 +15,28 @@
 #include "Engine/EngineTypes.h"
 #include "PropertyEditorModule.h"
 #include "SuzieDecompressionHelper.h"
+#include "SuzieDumpCache.h"
+#include "SuzieDumpDiff.h"
+#include "SuzieDumpShards.h"
+#include "SuzieFlagNameTable.h"
+#include "SuzieFramedCompression.h"
+#include "SuzieGenerationStats.h"
+#include "SuzieMappedFile.h"
+#include "SuzieNameTable.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "UObject/UObjectAllocator.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Algo/StableSort.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/PackageName.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include <atomic>
+#include <type_traits>
 #include "Engine/NetConnection.h"
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
 #include "UObject/PropertyOptional.h"
@@ -27,24 +46,121 @@ DEFINE_LOG_CATEGORY(LogSuzie);
 
 #define LOCTEXT_NAMESPACE "FSuziePluginModule"
 
+static TAutoConsoleVariable<bool> CVarSuzieLazyClassGeneration(
+    TEXT("Suzie.LazyClassGeneration"),
+    false,
+    TEXT("When enabled, dynamic classes are only generated once they are referenced by project assets, listed in LazyGenerationRootClasses ")
+    TEXT("in the [Suzie] section of the engine config, or requested through Suzie.GenerateClass. Structs, enums and functions are generated as dependencies of these classes."),
+    ECVF_ReadOnly);
+
+static TAutoConsoleVariable<bool> CVarSuzieHotReload(
+    TEXT("Suzie.HotReload"),
+    true,
+    TEXT("When enabled, class definition files are watched for changes in the editor, and classes, structs, enums and functions that have been added to them are generated without restarting. ")
+    TEXT("Objects that already exist are never changed, changes to their layout require an editor restart."),
+    ECVF_ReadOnly);
+
+static TAutoConsoleVariable<bool> CVarSuzieReportJsonMemory(
+    TEXT("Suzie.ReportJsonMemory"),
+    false,
+    TEXT("When enabled, the size of the parsed class definition files is estimated, and the generation summary reports the peak and the retained size of the parsed files. ")
+    TEXT("Estimating the size requires an additional pass over the parsed files."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarSuzieReorderPropertiesByAlignment(
+    TEXT("Suzie.ReorderPropertiesByAlignment"),
+    false,
+    TEXT("When enabled, properties of dynamic classes and structs are laid out in the order of decreasing alignment instead of the order they are declared in, ")
+    TEXT("which removes most of the padding between them and makes instances smaller. Changes the order properties are listed in, e.g. in the details panel."),
+    ECVF_ReadOnly);
+
+static TAutoConsoleVariable<bool> CVarSuzieBulkContainerDeserialization(
+    TEXT("Suzie.BulkContainerDeserialization"),
+    true,
+    TEXT("When enabled, arrays of numbers and booleans are decoded by writing their elements directly, and empty sets and maps reserve space for all of their elements up front. ")
+    TEXT("Disabling it decodes every element through the generic path, which is only useful to compare the two, see Suzie.Benchmark.Containers."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSuzieArchetypeStrategy(
+    TEXT("Suzie.ArchetypeStrategy"),
+    1,
+    TEXT("Determines how the archetypes that instances of dynamic classes are initialized from are created from the class default objects.\n")
+    TEXT("0: Duplicate the CDO with DuplicateObject. Goes through serialization of the CDO and its subobjects.\n")
+    TEXT("1: Construct the archetype from the CDO and copy property values directly (default).\n")
+    TEXT("2: Like 1, but the archetype is only created when the first instance of the class is constructed on the game thread. Saves memory for classes that are never instantiated.\n")
+    TEXT("   Falls back to 1 when packages are loaded on the async loading thread, since instances created by the loader would never get the archetype."),
+    ECVF_ReadOnly);
+
+static FAutoConsoleCommand SuzieGenerateClassCommand(
+    TEXT("Suzie.GenerateClass"),
+    TEXT("Generates the dynamic class with the given path if it has not been generated yet. Only has an effect when Suzie.LazyClassGeneration is enabled."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        for (const FString& ClassPath : Args)
+        {
+            const UClass* Class = FModuleManager::GetModuleChecked<FSuziePluginModule>(TEXT("Suzie")).ResolveDynamicClass(ClassPath);
+            UE_LOG(LogSuzie, Display, TEXT("%s: %s"), *ClassPath, Class ? TEXT("generated") : TEXT("not found"));
+        }
+    }));
+
 void FSuziePluginModule::StartupModule()
 {
     UE_LOG(LogSuzie, Display, TEXT("Suzie plugin starting"));
 
-    ProcessAllJsonClassDefinitions();
+    // Benchmark runs generate classes from their own directory and do not want the project classes to be generated first
+    if (FParse::Param(FCommandLine::Get(), TEXT("SuzieNoStartupGeneration")))
+    {
+        UE_LOG(LogSuzie, Display, TEXT("Skipping class generation at startup"));
+        return;
+    }
+
+    ProcessAllJsonClassDefinitions(GetJsonClassDefinitionDirectory());
+
+    if (!LazyGenerationContexts.IsEmpty() || !LazyShardedDumps.IsEmpty())
+    {
+        GenerateLazyRootClasses();
+    }
+    if (IsHotReloadEnabled())
+    {
+        StartWatchingJsonClassDefinitions();
+    }
 }
 
 void FSuziePluginModule::ShutdownModule()
 {
     UE_LOG(LogSuzie, Display, TEXT("Suzie plugin shutting down"));
+
+    StopWatchingJsonClassDefinitions();
+
+    if (OnAssetAddedDelegateHandle.IsValid())
+    {
+        if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+        {
+            AssetRegistry->OnAssetAdded().Remove(OnAssetAddedDelegateHandle);
+        }
+        OnAssetAddedDelegateHandle.Reset();
+    }
+    LazyGenerationContexts.Empty();
+    LazyShardedDumps.Empty();
+    StructDeserializationPlans.Empty();
 }
 
-void FSuziePluginModule::ProcessAllJsonClassDefinitions()
+// Formats that are faster to decode are preferred when the same dump is present in multiple formats
+static int32 GetJsonClassDefinitionCompressionPriority(const EJsonClassDefinitionCompression Compression)
 {
-    
-    // Define where we expect JSON class definitions to be
-    const FString JsonClassesPath = FPaths::ProjectContentDir() / TEXT("DynamicClasses");
-    
+    switch (Compression)
+    {
+    case EJsonClassDefinitionCompression::None: return 2;
+    case EJsonClassDefinitionCompression::FramedLZ4: return 1;
+    default: return 0;
+    }
+}
+
+void FSuziePluginModule::ProcessAllJsonClassDefinitions(const FString& JsonClassesPath)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(Suzie_ProcessAllJsonClassDefinitions);
+    FSuzieGenerationStats::Get().BeginRun();
+
     // Check if directory exists
     if (!FPlatformFileManager::Get().GetPlatformFile().DirectoryExists(*JsonClassesPath))
     {
@@ -52,160 +168,992 @@ void FSuziePluginModule::ProcessAllJsonClassDefinitions()
         return;
     }
     
+    // Find all sharded dumps. Sharded dumps are preferred over the files of the same dump
+    TArray<FString> ShardDirectoryNames;
+    IFileManager::Get().FindFiles(ShardDirectoryNames, *(JsonClassesPath / FString(TEXT("*")) + FSuzieShardManifest::ShardDirectoryExtension), false, true);
+
+    TArray<TPair<FString, TSharedRef<FSuzieShardManifest>>> ShardedDumps;
+    TSet<FString> ShardedDumpNames;
+    for (const FString& ShardDirectoryName : ShardDirectoryNames)
+    {
+        const TSharedRef<FSuzieShardManifest> Manifest = MakeShared<FSuzieShardManifest>();
+        if (!FSuzieShardManifest::Load(JsonClassesPath / ShardDirectoryName, *Manifest))
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Failed to load shard manifest: %s"), *FSuzieShardManifest::GetManifestFilePath(JsonClassesPath / ShardDirectoryName));
+            continue;
+        }
+        ShardedDumps.Add({JsonClassesPath / ShardDirectoryName, Manifest});
+        ShardedDumpNames.Add(ShardDirectoryName.LeftChop(FCString::Strlen(FSuzieShardManifest::ShardDirectoryExtension)));
+    }
+
     // Find all JSON files and compressed JSON files
-    TArray<FString> JsonFileNames;
-    IFileManager::Get().FindFiles(JsonFileNames, *JsonClassesPath, TEXT("*.jmap"));
+    TArray<FString> DefinitionFileNames;
+    IFileManager::Get().FindFiles(DefinitionFileNames, *(JsonClassesPath / TEXT("*.jmap*")), true, false);
 
-    TArray<FString> CompressedJsonFileNames;
-    IFileManager::Get().FindFiles(CompressedJsonFileNames, *JsonClassesPath, TEXT("*.jmap.gz"));
-    
-    UE_LOG(LogSuzie, Display, TEXT("Found %d JSON class definition files"), JsonFileNames.Num() + CompressedJsonFileNames.Num());
+    // The same dump can be present in multiple formats, e.g. after it has been re-packed. Only the one that is the fastest to decode is loaded
+    TMap<FString, FJsonClassDefinitionFile> DefinitionFilesByDumpName;
+    for (const FString& DefinitionFileName : DefinitionFileNames)
+    {
+        EJsonClassDefinitionCompression Compression;
+        if (!GetJsonClassDefinitionFileCompression(DefinitionFileName, Compression))
+        {
+            continue;
+        }
+        const FString DumpName = DefinitionFileName.Left(DefinitionFileName.Find(TEXT(".jmap"), ESearchCase::IgnoreCase, ESearchDir::FromEnd));
+        if (ShardedDumpNames.Contains(DumpName))
+        {
+            UE_LOG(LogSuzie, Display, TEXT("Skipping %s in favor of its sharded dump"), *DefinitionFileName);
+            continue;
+        }
+        FJsonClassDefinitionFile* ExistingDefinitionFile = DefinitionFilesByDumpName.Find(DumpName);
+        if (ExistingDefinitionFile == nullptr || GetJsonClassDefinitionCompressionPriority(Compression) > GetJsonClassDefinitionCompressionPriority(ExistingDefinitionFile->Compression))
+        {
+            if (ExistingDefinitionFile)
+            {
+                UE_LOG(LogSuzie, Display, TEXT("Skipping %s in favor of %s"), *ExistingDefinitionFile->FileName, *DefinitionFileName);
+            }
+            DefinitionFilesByDumpName.Add(DumpName, {DefinitionFileName, Compression});
+        }
+        else
+        {
+            UE_LOG(LogSuzie, Display, TEXT("Skipping %s in favor of %s"), *DefinitionFileName, *ExistingDefinitionFile->FileName);
+        }
+    }
+    UE_LOG(LogSuzie, Display, TEXT("Found %d JSON class definition files and %d sharded dumps"), DefinitionFilesByDumpName.Num(), ShardedDumps.Num());
 
-    // This can potentially take some time so show a progress task
-    const int32 TotalAmountOfWork = JsonFileNames.Num() + CompressedJsonFileNames.Num();
+    // Plain JSON files are processed first, followed by the compressed ones
+    TArray<FJsonClassDefinitionFile> DefinitionFiles;
+    DefinitionFilesByDumpName.GenerateValueArray(DefinitionFiles);
+    Algo::StableSortBy(DefinitionFiles, [](const FJsonClassDefinitionFile& DefinitionFile) { return DefinitionFile.Compression; });
+
+    // This can potentially take some time so show a progress task. Parsing all files counts as one unit of work
+    const int32 TotalAmountOfWork = DefinitionFiles.Num() + ShardedDumps.Num() + 1;
     FScopedSlowTask GenerateDynamicClassesTask(TotalAmountOfWork, LOCTEXT("GeneratingDynamicClasses", "Suzie: Generating Dynamic Classes"));
     GenerateDynamicClassesTask.Visibility = ESlowTaskVisibility::ForceVisible;
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3    
     GenerateDynamicClassesTask.Visibility = ESlowTaskVisibility::Important;
     GenerateDynamicClassesTask.ForceRefresh();
 #endif
-    
-    // Process each JSON file
-    for (const FString& JsonFileName : JsonFileNames)
-    {
-        GenerateDynamicClassesTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ProcessingJsonFile", "Generating classes for file {0}"), FText::AsCultureInvariant(JsonFileName)));
+
+    GenerateDynamicClassesTask.EnterProgressFrame(1, LOCTEXT("ParsingJsonFiles", "Parsing class definition files"));
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3    
-        GenerateDynamicClassesTask.ForceRefresh();
+    GenerateDynamicClassesTask.ForceRefresh();
 #endif
-        UE_LOG(LogSuzie, Display, TEXT("Processing JSON class definition: %s"), *JsonFileName);
-    
-        // Read the JSON file
-        FString JsonContent;
-        if (!FFileHelper::LoadFileToString(JsonContent, *(JsonClassesPath / JsonFileName)))
+
+    // Reading, decompressing and parsing the files does not touch any UObjects, so all files can be processed concurrently on the task graph
+    // The same goes for hashing the objects of the files for hot reload, which would otherwise be done one file at a time on the game thread below
+    const bool bCreateSignatures = IsHotReloadEnabled();
+    ParallelFor(DefinitionFiles.Num(), [&](const int32 FileIndex)
+    {
+        FJsonClassDefinitionFile& DefinitionFile = DefinitionFiles[FileIndex];
+        DefinitionFile.GenerationContext = LoadJsonClassDefinitionFile(JsonClassesPath / DefinitionFile.FileName, DefinitionFile.Compression);
+        if (bCreateSignatures && DefinitionFile.GenerationContext.IsValid())
         {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to read JSON file: %s"), *JsonFileName);
-            return;
+            DefinitionFile.Signature = MakeShared<FSuzieDumpSignature>(FSuzieDumpSignature::Create(*DefinitionFile.GenerationContext));
         }
+    });
     
-        // Parse the JSON
-        TSharedPtr<FJsonObject> JsonObject;
-        TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonContent);
-        if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+    // Class generation creates UObjects, so it has to run on the game thread one file at a time
+    for (FJsonClassDefinitionFile& DefinitionFile : DefinitionFiles)
+    {
+        GenerateDynamicClassesTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ProcessingJsonFile", "Generating classes for file {0}"), FText::AsCultureInvariant(DefinitionFile.FileName)));
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3    
+        GenerateDynamicClassesTask.ForceRefresh();
+#endif
+        // Files that failed to load or parse have already been reported by LoadJsonClassDefinitionFile
+        if (!DefinitionFile.GenerationContext.IsValid())
         {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to parse JSON in file: %s"), *JsonFileName);
             continue;
         }
-        CreateDynamicClassesForJsonObject(JsonObject);
+        UE_LOG(LogSuzie, Display, TEXT("Generating classes for JSON class definition: %s"), *DefinitionFile.FileName);
+
+        // Take the parsed file out of the list so that its memory is released as soon as its classes have been generated
+        const TSharedPtr<FDynamicClassGenerationContext> GenerationContext = MoveTemp(DefinitionFile.GenerationContext);
+        RegisterLoadedDefinitionFile(DefinitionFile.FileName, GenerationContext.ToSharedRef(), DefinitionFile.Signature);
+        CreateDynamicClassesForContext(GenerationContext.ToSharedRef());
     }
-    
-    // Process each compressed JSON file
-    for (const FString& CompressedJsonFileName : CompressedJsonFileNames)
+
+    // Sharded dumps are processed last, since files of their own cannot reference them
+    for (const TPair<FString, TSharedRef<FSuzieShardManifest>>& ShardedDump : ShardedDumps)
     {
-        GenerateDynamicClassesTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ProcessingJsonFile", "Generating classes for file {0}"), FText::AsCultureInvariant(CompressedJsonFileName)));
+        GenerateDynamicClassesTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ProcessingShardedDump", "Generating classes for sharded dump {0}"), FText::AsCultureInvariant(FPaths::GetCleanFilename(ShardedDump.Key))));
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3    
         GenerateDynamicClassesTask.ForceRefresh();
 #endif
-        UE_LOG(LogSuzie, Display, TEXT("Processing compressed JSON class definition: %s"), *CompressedJsonFileName);
+        ProcessShardedJsonClassDefinitions(ShardedDump.Key, ShardedDump.Value);
+    }
+
+    // Parsed files have been released by now, but the allocator keeps their memory cached. Return it to the system, since nothing is going to reuse it soon
+    FMemory::Trim();
+
+    // Lazy class generation defers most of the work, in which case this only covers parsing and indexing
+    FSuzieGenerationStats::Get().LogSummary(TEXT("Dynamic class generation"));
+}
 
-        // Read binary file contents
-        TArray<uint8> CompressedFileContents;
-        if (!FFileHelper::LoadFileToArray(CompressedFileContents, *(JsonClassesPath / CompressedJsonFileName)))
+void FSuziePluginModule::ProcessShardedJsonClassDefinitions(const FString& ShardDirectory, const TSharedRef<FSuzieShardManifest>& Manifest)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(Suzie_ProcessShardedJsonClassDefinitions);
+
+    // In lazy mode only the manifest is retained, and shards are loaded once a class defined by them is resolved
+    if (CVarSuzieLazyClassGeneration.GetValueOnGameThread())
+    {
+        FLazyShardedJsonClassDefinitions& ShardedDump = LazyShardedDumps.AddDefaulted_GetRef();
+        ShardedDump.ShardDirectory = ShardDirectory;
+        ShardedDump.Manifest = Manifest;
+        ShardedDump.LoadedShards.Init(false, Manifest->Shards.Num());
+        UE_LOG(LogSuzie, Display, TEXT("Registered %d shards of %s for lazy class generation"), Manifest->Shards.Num(), *FPaths::GetCleanFilename(ShardDirectory));
+        return;
+    }
+
+    const auto ParseShardAsync = [&ShardDirectory, &Manifest](const int32 ShardIndex)
+    {
+        const FString ShardFilePath = ShardDirectory / Manifest->Shards[ShardIndex].FileName;
+        return Async(EAsyncExecution::ThreadPool, [ShardFilePath]() -> TSharedPtr<FDynamicClassGenerationContext>
         {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to read compressed JSON file: %s"), *CompressedJsonFileName);
-            return;
+            EJsonClassDefinitionCompression Compression = EJsonClassDefinitionCompression::None;
+            GetJsonClassDefinitionFileCompression(ShardFilePath, Compression);
+            return LoadJsonClassDefinitionFile(ShardFilePath, Compression);
+        });
+    };
+
+    FScopedSlowTask GenerateShardsTask(Manifest->Shards.Num());
+    TBitArray<> FailedShards(false, Manifest->Shards.Num());
+    TFuture<TSharedPtr<FDynamicClassGenerationContext>> NextShardContext = Manifest->Shards.IsEmpty() ? TFuture<TSharedPtr<FDynamicClassGenerationContext>>() : ParseShardAsync(0);
+
+    for (int32 ShardIndex = 0; ShardIndex < Manifest->Shards.Num(); ShardIndex++)
+    {
+        const FSuzieDumpShard& Shard = Manifest->Shards[ShardIndex];
+        GenerateShardsTask.EnterProgressFrame(1, FText::Format(LOCTEXT("ProcessingShard", "Generating classes for shard {0}"), FText::AsCultureInvariant(Shard.FileName)));
+
+        // Parse the next shard while the classes of this one are generated
+        TSharedPtr<FDynamicClassGenerationContext> Context = NextShardContext.Get();
+        NextShardContext = ShardIndex + 1 < Manifest->Shards.Num() ? ParseShardAsync(ShardIndex + 1) : TFuture<TSharedPtr<FDynamicClassGenerationContext>>();
+
+        // Objects of this shard cannot be generated without the objects of the shards it depends on
+        const int32* FailedDependencyIndex = Shard.Dependencies.FindByPredicate([&](const int32 DependencyIndex) { return FailedShards[DependencyIndex]; });
+        if (FailedDependencyIndex)
+        {
+            UE_LOG(LogSuzie, Error, TEXT("Skipping shard %s because shard %s it depends on has failed to load"), *Shard.FileName, *Manifest->Shards[*FailedDependencyIndex].FileName);
+            FailedShards[ShardIndex] = true;
+            continue;
+        }
+        // Shards that failed to load or parse have already been reported by LoadJsonClassDefinitionFile
+        if (!Context.IsValid())
+        {
+            FailedShards[ShardIndex] = true;
+            continue;
+        }
+
+        // Parsed shard is released as soon as its classes have been finalized
+        UE_LOG(LogSuzie, Verbose, TEXT("Generating classes for shard: %s"), *Shard.FileName);
+        CreateDynamicClassesForContext(Context.ToSharedRef());
+    }
+}
+
+bool FSuziePluginModule::LoadShardForObjectPath(const FString& ObjectPath)
+{
+    // Objects that already exist, e.g. native classes, do not need their shard
+    if (FindObject<UObject>(nullptr, *ObjectPath))
+    {
+        return false;
+    }
+    const FString PackageName = FPackageName::ObjectPathToPackageName(ObjectPath);
+    for (FLazyShardedJsonClassDefinitions& ShardedDump : LazyShardedDumps)
+    {
+        const int32 ShardIndex = ShardedDump.Manifest->FindShardForPackage(PackageName);
+        if (ShardIndex != INDEX_NONE)
+        {
+            return LoadShardForLazyGeneration(ShardedDump, ShardIndex);
         }
+    }
+    return false;
+}
+
+bool FSuziePluginModule::LoadShardForLazyGeneration(FLazyShardedJsonClassDefinitions& ShardedDump, const int32 ShardIndex)
+{
+    // Shards are only attempted once, even if they fail to load
+    if (ShardedDump.LoadedShards[ShardIndex])
+    {
+        return false;
+    }
+    ShardedDump.LoadedShards[ShardIndex] = true;
 
-        // Attempt to decompress the file as Gzip archive
+    // Load the shards this shard depends on first
+    const FSuzieDumpShard& Shard = ShardedDump.Manifest->Shards[ShardIndex];
+    for (const int32 DependencyIndex : Shard.Dependencies)
+    {
+        LoadShardForLazyGeneration(ShardedDump, DependencyIndex);
+    }
+
+    UE_LOG(LogSuzie, Display, TEXT("Loading shard %s for lazy class generation"), *Shard.FileName);
+    const FString ShardFilePath = ShardedDump.ShardDirectory / Shard.FileName;
+    EJsonClassDefinitionCompression Compression = EJsonClassDefinitionCompression::None;
+    GetJsonClassDefinitionFileCompression(ShardFilePath, Compression);
+    const TSharedPtr<FDynamicClassGenerationContext> Context = LoadJsonClassDefinitionFile(ShardFilePath, Compression);
+    if (!Context.IsValid())
+    {
+        return false;
+    }
+
+    // Objects of this shard can only be created once the objects they reference from other shards exist, so generate the imports now
+    for (const FString& Import : Shard.Imports)
+    {
+        if (FindObject<UObject>(nullptr, *Import))
+        {
+            continue;
+        }
+        for (int32 ContextIndex = 0; ContextIndex < LazyGenerationContexts.Num(); ContextIndex++)
+        {
+            const TSharedPtr<FDynamicClassGenerationContext> ImportContext = LazyGenerationContexts[ContextIndex];
+            const FDynamicObjectRecord* ImportRecord = ImportContext->FindObjectRecord(Import);
+            if (ImportRecord == nullptr)
+            {
+                continue;
+            }
+            if (ImportRecord->Type == EDynamicObjectType::Class)
+            {
+                ResolveDynamicClass(Import);
+            }
+            else
+            {
+                CreateDynamicObjectForRecord(*ImportContext, *ImportRecord);
+                ConstructAndFinalizePendingClasses(*ImportContext);
+            }
+            break;
+        }
+    }
+    LazyGenerationContexts.Add(Context);
+    return true;
+}
+
+FString FSuziePluginModule::GetJsonClassDefinitionDirectory()
+{
+    // Define where we expect JSON class definitions to be
+    return FPaths::ProjectContentDir() / TEXT("DynamicClasses");
+}
+
+bool FSuziePluginModule::GetJsonClassDefinitionFileCompression(const FString& FileName, EJsonClassDefinitionCompression& OutCompression)
+{
+    if (FileName.EndsWith(TEXT(".jmap")))
+    {
+        OutCompression = EJsonClassDefinitionCompression::None;
+        return true;
+    }
+    if (FileName.EndsWith(TEXT(".jmap.gz")))
+    {
+        OutCompression = EJsonClassDefinitionCompression::Gzip;
+        return true;
+    }
+    if (FileName.EndsWith(TEXT(".jmap.lz4")))
+    {
+        OutCompression = EJsonClassDefinitionCompression::FramedLZ4;
+        return true;
+    }
+    return false;
+}
+
+// Approximates the heap memory held by a parsed JSON value. Every value and object is a separate allocation that also holds its shared reference controller
+static int64 GetJsonValueAllocatedSize(const FJsonValue& Value);
+
+static int64 GetJsonObjectAllocatedSize(const FJsonObject& Object)
+{
+    int64 Size = Object.Values.GetAllocatedSize();
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+    {
+        Size += Field.Key.GetAllocatedSize() + GetJsonValueAllocatedSize(*Field.Value);
+    }
+    return Size;
+}
+
+static int64 GetJsonValueAllocatedSize(const FJsonValue& Value)
+{
+    constexpr int64 ReferenceControllerSize = 16;
+    switch (Value.Type)
+    {
+    case EJson::String:
+        return sizeof(FJsonValueString) + ReferenceControllerSize + Value.AsString().GetAllocatedSize();
+    case EJson::Array:
+        {
+            int64 Size = sizeof(FJsonValueArray) + ReferenceControllerSize + Value.AsArray().GetAllocatedSize();
+            for (const TSharedPtr<FJsonValue>& Element : Value.AsArray())
+            {
+                Size += GetJsonValueAllocatedSize(*Element);
+            }
+            return Size;
+        }
+    case EJson::Object:
+        return sizeof(FJsonValueObject) + sizeof(FJsonObject) + 2 * ReferenceControllerSize + GetJsonObjectAllocatedSize(*Value.AsObject());
+    default:
+        return sizeof(FJsonValueNumber) + ReferenceControllerSize;
+    }
+}
+
+// Maps the class definition file. The contents are parsed straight from the mapping when the file is not compressed
+static TUniquePtr<FSuzieMappedFile> OpenJsonClassDefinitionFile(const FString& FilePath)
+{
+    SUZIE_SCOPED_PHASE(FileRead);
+    TUniquePtr<FSuzieMappedFile> SourceFile = FSuzieMappedFile::Open(FilePath);
+    if (!SourceFile)
+    {
+        UE_LOG(LogSuzie, Error, TEXT("Failed to read JSON file: %s"), *FPaths::GetCleanFilename(FilePath));
+        return nullptr;
+    }
+    SUZIE_INCREMENT_COUNTER(FilesLoaded);
+    SUZIE_INCREMENT_COUNTER(BytesRead, SourceFile->GetSize());
+    return SourceFile;
+}
+
+TSharedPtr<FJsonObject> FSuziePluginModule::ParseJsonClassDefinitionFile(const FString& FilePath, const EJsonClassDefinitionCompression Compression)
+{
+    TUniquePtr<FSuzieMappedFile> SourceFile = OpenJsonClassDefinitionFile(FilePath);
+    return SourceFile ? ParseJsonClassDefinitionFileContents(FPaths::GetCleanFilename(FilePath), MoveTemp(SourceFile), Compression) : nullptr;
+}
+
+TSharedPtr<FDynamicClassGenerationContext> FSuziePluginModule::LoadJsonClassDefinitionFile(const FString& FilePath, const EJsonClassDefinitionCompression Compression)
+{
+    const FString FileName = FPaths::GetCleanFilename(FilePath);
+
+    // Map the source file contents. They are needed to validate the pre-compiled cache, and to parse the file if the cache is stale
+    TUniquePtr<FSuzieMappedFile> SourceFile = OpenJsonClassDefinitionFile(FilePath);
+    if (!SourceFile)
+    {
+        return nullptr;
+    }
+    uint64 SourceHash = 0;
+    {
+        SUZIE_SCOPED_PHASE(FileRead);
+        SourceHash = FSuzieDumpCache::HashSourceFileContents(SourceFile->GetData(), SourceFile->GetSize());
+    }
+
+    // Use the pre-compiled records of the file if they have been written for this exact file and engine version
+    const FString CacheFilePath = FSuzieDumpCache::GetCacheFilePath(FilePath);
+    {
+        SUZIE_SCOPED_PHASE(CacheLoad);
+        if (TSharedPtr<FDynamicClassGenerationContext> CachedContext = FSuzieDumpCache::Load(CacheFilePath, SourceHash))
+        {
+            UE_LOG(LogSuzie, Display, TEXT("Loaded pre-compiled class definition cache for: %s"), *FileName);
+            SUZIE_INCREMENT_COUNTER(CacheHits);
+            if (CVarSuzieReportJsonMemory.GetValueOnAnyThread())
+            {
+                for (const FDynamicObjectRecord& ObjectRecord : CachedContext->ObjectRecords)
+                {
+                    CachedContext->JsonDefinitionBytes += sizeof(FJsonObject) + GetJsonObjectAllocatedSize(*ObjectRecord.Definition);
+                }
+                FSuzieGenerationStats::Get().AddLiveJsonBytes(CachedContext->JsonDefinitionBytes);
+            }
+            return CachedContext;
+        }
+    }
+
+    const TSharedPtr<FJsonObject> RootObject = ParseJsonClassDefinitionFileContents(FileName, MoveTemp(SourceFile), Compression);
+    const TSharedPtr<FDynamicClassGenerationContext> Context = RootObject ? CreateGenerationContextForJsonObject(RootObject) : nullptr;
+    if (!Context.IsValid())
+    {
+        return nullptr;
+    }
+
+    // Write the pre-compiled records so that the next launch does not need to parse and index the file again
+    SUZIE_SCOPED_PHASE(CacheSave);
+    FSuzieDumpCache::Save(CacheFilePath, SourceHash, *Context);
+    return Context;
+}
+
+TSharedPtr<FJsonObject> FSuziePluginModule::ParseJsonClassDefinitionFileContents(const FString& FileName, TUniquePtr<FSuzieMappedFile> SourceFile, const EJsonClassDefinitionCompression Compression)
+{
+    TSharedPtr<FJsonObject> JsonObject;
+    if (Compression != EJsonClassDefinitionCompression::None)
+    {
+        UE_LOG(LogSuzie, Display, TEXT("Processing compressed JSON class definition: %s"), *FileName);
+
+        // Attempt to decompress the file as Gzip archive, or as multi-frame LZ4 archive that is decompressed in parallel
         TArray<uint8> DecompressedFileContents;
-        if (!FSuzieDecompressionHelper::DecompressMemoryGzip(CompressedFileContents, DecompressedFileContents))
         {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to decompress compressed JSON file as valid GZIP: %s"), *CompressedJsonFileName);
-            return;
+            SUZIE_SCOPED_PHASE(Decompression);
+            const TConstArrayView<uint8> CompressedFileContents(SourceFile->GetData(), (int32)SourceFile->GetSize());
+            if (Compression == EJsonClassDefinitionCompression::FramedLZ4)
+            {
+                if (!FSuzieFramedCompression::DecompressMemory(CompressedFileContents, DecompressedFileContents))
+                {
+                    UE_LOG(LogSuzie, Error, TEXT("Failed to decompress compressed JSON file as valid framed LZ4 archive: %s"), *FileName);
+                    return nullptr;
+                }
+            }
+            else if (!FSuzieDecompressionHelper::DecompressMemoryGzip(CompressedFileContents, DecompressedFileContents))
+            {
+                UE_LOG(LogSuzie, Error, TEXT("Failed to decompress compressed JSON file as valid GZIP: %s"), *FileName);
+                return nullptr;
+            }
+            SUZIE_INCREMENT_COUNTER(BytesDecompressed, DecompressedFileContents.Num());
         }
+        SourceFile.Reset();
+
+        // Parse the decompressed document in place, without converting it into a string first
+        SUZIE_SCOPED_PHASE(JsonParsing);
+        JsonObject = ParseJsonObjectFromBuffer(DecompressedFileContents.GetData(), DecompressedFileContents.Num());
+    }
+    else
+    {
+        UE_LOG(LogSuzie, Display, TEXT("Processing JSON class definition: %s"), *FileName);
+        SUZIE_SCOPED_PHASE(JsonParsing);
+
+        // Parse the document straight from the file mapping. Pages are read by the OS as the parser reaches them,
+        // and the document is neither copied into memory nor converted to UTF-16. Only the values kept in the parsed objects are copied
+        JsonObject = ParseJsonObjectFromBuffer(SourceFile->GetData(), SourceFile->GetSize());
+        SourceFile.Reset();
+    }
+
+    if (!JsonObject.IsValid())
+    {
+        UE_LOG(LogSuzie, Error, TEXT("Failed to parse JSON in file: %s"), *FileName);
+        return nullptr;
+    }
+    return JsonObject;
+}
+
+TSharedPtr<FJsonObject> FSuziePluginModule::ParseJsonObjectFromBuffer(const uint8* Data, const int64 Size)
+{
+    // Documents are read through string views, which are limited to 2 GB. No dump is expected to reach that size
+    if (Size > MAX_int32)
+    {
+        UE_LOG(LogSuzie, Error, TEXT("JSON document of %lld bytes exceeds the maximum supported size"), Size);
+        return nullptr;
+    }
 
-        // Parse the binary stream into the string. UE will attempt to guess the encoding for us
+    TSharedPtr<FJsonObject> JsonObject;
+
+    // Dumps are UTF-8, but handle UTF-16 documents through the generic path that converts them into a string first
+    const bool bIsUtf16 = Size >= 2 && ((Data[0] == 0xFF && Data[1] == 0xFE) || (Data[0] == 0xFE && Data[1] == 0xFF));
+    if (bIsUtf16)
+    {
         FString JsonContent;
-        FFileHelper::BufferToString(JsonContent, DecompressedFileContents.GetData(), DecompressedFileContents.Num());
-        
-        // Parse the JSON
-        TSharedPtr<FJsonObject> JsonObject;
-        TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonContent);
-        if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+        FFileHelper::BufferToString(JsonContent, Data, (int32)Size);
+        const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonContent);
+        if (!FJsonSerializer::Deserialize(JsonReader, JsonObject))
         {
-            UE_LOG(LogSuzie, Error, TEXT("Failed to parse compressed JSON in file: %s"), *CompressedJsonFileName);
-            continue;
+            return nullptr;
         }
-        CreateDynamicClassesForJsonObject(JsonObject);
+        return JsonObject;
     }
+
+    // Skip UTF-8 byte order mark if present, and read the document directly as UTF-8 without making a copy of it
+    const bool bHasUtf8ByteOrderMark = Size >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF;
+    const int64 DocumentOffset = bHasUtf8ByteOrderMark ? 3 : 0;
+    const FUtf8StringView JsonView(reinterpret_cast<const UTF8CHAR*>(Data + DocumentOffset), (int32)(Size - DocumentOffset));
+
+    const TSharedRef<TJsonReader<UTF8CHAR>> JsonReader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(JsonView);
+    if (!FJsonSerializer::Deserialize(JsonReader, JsonObject))
+    {
+        return nullptr;
+    }
+    return JsonObject;
+}
+
+FDynamicClassGenerationContext::FDynamicClassGenerationContext() : NameTable(MakeUnique<FSuzieNameTable>())
+{
 }
 
-void FSuziePluginModule::CreateDynamicClassesForJsonObject(const TSharedPtr<FJsonObject>& RootObject)
+FDynamicClassGenerationContext::~FDynamicClassGenerationContext()
 {
+    ReleaseDefinitions();
+}
+
+void FDynamicClassGenerationContext::ReleaseDefinitions()
+{
+    for (FDynamicObjectRecord& ObjectRecord : ObjectRecords)
+    {
+        ObjectRecord.Definition.Reset();
+    }
+    NameTable->Reset();
+    if (JsonDefinitionBytes != 0)
+    {
+        FSuzieGenerationStats::Get().AddLiveJsonBytes(-JsonDefinitionBytes);
+        JsonDefinitionBytes = 0;
+    }
+}
+
+TSharedPtr<FDynamicClassGenerationContext> FSuziePluginModule::CreateGenerationContextForJsonObject(const TSharedPtr<FJsonObject>& RootObject)
+{
+    SUZIE_SCOPED_PHASE(Indexing);
     const TSharedPtr<FJsonObject>* Objects;
     if (!RootObject->TryGetObjectField(TEXT("objects"), Objects))
     {
         UE_LOG(LogSuzie, Error, TEXT("Missing 'objects' map"));
+        return nullptr;
+    }
+
+    const TSharedRef<FDynamicClassGenerationContext> Context = MakeShared<FDynamicClassGenerationContext>();
+    if (CVarSuzieReportJsonMemory.GetValueOnAnyThread())
+    {
+        Context->JsonDefinitionBytes = GetJsonObjectAllocatedSize(*RootObject);
+        FSuzieGenerationStats::Get().AddLiveJsonBytes(Context->JsonDefinitionBytes);
+    }
+    Context->ObjectRecords.Reserve((*Objects)->Values.Num());
+    Context->ObjectRecordIndices.Reserve((*Objects)->Values.Num());
+
+    // Assign record indices to all objects first so that child lists can be resolved to indices in the second pass
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Object : (*Objects)->Values)
+    {
+        const TSharedPtr<FJsonObject>* ObjectDefinition;
+        if (!Object.Value->TryGetObject(ObjectDefinition))
+        {
+            UE_LOG(LogSuzie, Warning, TEXT("Skipping malformed object definition %s"), *Object.Key);
+            continue;
+        }
+        const FName ObjectPath(*Object.Key);
+        Context->ObjectRecordIndices.Add(ObjectPath, Context->ObjectRecords.Num());
+
+        FDynamicObjectRecord& ObjectRecord = Context->ObjectRecords.AddDefaulted_GetRef();
+        ObjectRecord.ObjectPath = ObjectPath;
+        ObjectRecord.Definition = *ObjectDefinition;
+
+        // Paths of the objects are unique, but outer paths and names of subobjects are shared between many objects
+        FStringView OuterPath;
+        FStringView ObjectName;
+        ParseObjectPath(Object.Key, OuterPath, ObjectName);
+        ObjectRecord.OuterPath = Context->NameTable->FindOrAdd(OuterPath);
+        ObjectRecord.ObjectName = Context->NameTable->FindOrAdd(ObjectName);
+    }
+
+    // Decode the fields that generation looks up repeatedly. Fields that only make sense for some object types are simply absent for others
+    for (FDynamicObjectRecord& ObjectRecord : Context->ObjectRecords)
+    {
+        const FJsonObject& Definition = *ObjectRecord.Definition;
+
+        FString FieldValue;
+        if (Definition.TryGetStringField(TEXT("type"), FieldValue))
+        {
+            if (FieldValue == TEXT("Class"))
+            {
+                ObjectRecord.Type = EDynamicObjectType::Class;
+            }
+            else if (FieldValue == TEXT("ScriptStruct"))
+            {
+                ObjectRecord.Type = EDynamicObjectType::ScriptStruct;
+            }
+            else if (FieldValue == TEXT("Enum"))
+            {
+                ObjectRecord.Type = EDynamicObjectType::Enum;
+            }
+            else if (FieldValue == TEXT("Function"))
+            {
+                ObjectRecord.Type = EDynamicObjectType::Function;
+            }
+        }
+        if (Definition.TryGetStringField(TEXT("class"), FieldValue))
+        {
+            ObjectRecord.ClassPath = Context->NameTable->FindOrAdd(FieldValue);
+        }
+        if (Definition.TryGetStringField(TEXT("super_struct"), FieldValue) && !FieldValue.IsEmpty())
+        {
+            ObjectRecord.SuperStructPath = Context->NameTable->FindOrAdd(FieldValue);
+        }
+        if (Definition.TryGetStringField(TEXT("class_default_object"), FieldValue))
+        {
+            ObjectRecord.ClassDefaultObjectPath = FName(*FieldValue);
+        }
+        if (Definition.TryGetStringField(TEXT("object_flags"), FieldValue))
+        {
+            ObjectRecord.ObjectFlags = ParseObjectFlags(FieldValue);
+        }
+        if (Definition.TryGetStringField(TEXT("class_flags"), FieldValue))
+        {
+            ObjectRecord.ClassFlags = ParseClassFlags(FieldValue);
+        }
+        if (Definition.TryGetStringField(TEXT("struct_flags"), FieldValue))
+        {
+            ObjectRecord.StructFlags = ParseStructFlags(FieldValue);
+        }
+        if (Definition.TryGetStringField(TEXT("function_flags"), FieldValue))
+        {
+            ObjectRecord.FunctionFlags = ParseFunctionFlags(FieldValue);
+        }
+
+        // Children that are not part of the dump cannot be generated or deserialized, so they are dropped here
+        const TArray<TSharedPtr<FJsonValue>>* Children;
+        if (Definition.TryGetArrayField(TEXT("children"), Children))
+        {
+            ObjectRecord.Children.Reserve(Children->Num());
+            for (const TSharedPtr<FJsonValue>& ChildPathValue : *Children)
+            {
+                if (const int32* ChildRecordIndex = Context->ObjectRecordIndices.Find(FName(*ChildPathValue->AsString(), FNAME_Find)))
+                {
+                    ObjectRecord.Children.Add(*ChildRecordIndex);
+                }
+            }
+        }
+    }
+    return Context;
+}
+
+void FSuziePluginModule::CreateDynamicClassesForContext(const TSharedRef<FDynamicClassGenerationContext>& Context)
+{
+    // In lazy mode the context is retained and nothing is created until a class is resolved through it
+    if (CVarSuzieLazyClassGeneration.GetValueOnGameThread())
+    {
+        LazyGenerationContexts.Add(Context);
+        UE_LOG(LogSuzie, Display, TEXT("Registered %d objects for lazy class generation"), Context->ObjectRecords.Num());
+        return;
+    }
+
+    // Create classes, script structs and global delegate functions
+    for (const FDynamicObjectRecord& ObjectRecord : Context->ObjectRecords)
+    {
+        CreateDynamicObjectForRecord(*Context, ObjectRecord);
+    }
+
+    ConstructAndFinalizePendingClasses(*Context);
+
+    // Nothing is generated from the definitions once all classes have been finalized, so release them now instead of when the last reference to the context goes away
+    Context->ReleaseDefinitions();
+}
+
+void FSuziePluginModule::CreateDynamicObjectForRecord(FDynamicClassGenerationContext& Context, const FDynamicObjectRecord& ObjectRecord)
+{
+    const FString ObjectPath = ObjectRecord.ObjectPath.ToString();
+    if (ObjectRecord.Type == EDynamicObjectType::Class)
+    {
+        // Meatloaf bug (commit d8179e8): CDOs of UClass-derived native classes will be labeled with Class type, instead of "Object" type, which will result in a crash
+        // down the line due to the CDO being created with the wrong class type
+        if (ObjectRecord.ObjectName.ToString().StartsWith(TEXT("Default__")))
+        {
+            return;
+        }
+        UE_LOG(LogSuzie, Verbose, TEXT("Creating class %s"), *ObjectPath);
+        FindOrCreateClass(Context, ObjectPath);
+    }
+    else if (ObjectRecord.Type == EDynamicObjectType::ScriptStruct)
+    {
+        UE_LOG(LogSuzie, Verbose, TEXT("Creating struct %s"), *ObjectPath);
+        FindOrCreateScriptStruct(Context, ObjectPath);
+    }
+    else if (ObjectRecord.Type == EDynamicObjectType::Enum)
+    {
+        UE_LOG(LogSuzie, Verbose, TEXT("Creating enum %s"), *ObjectPath);
+        FindOrCreateEnum(Context, ObjectPath);
+    }
+    else if (ObjectRecord.Type == EDynamicObjectType::Function)
+    {
+        UE_LOG(LogSuzie, VeryVerbose, TEXT("Creating function %s"), *ObjectPath);
+        FindOrCreateFunction(Context, ObjectPath);
+    }
+}
+
+void FSuziePluginModule::RegisterLoadedDefinitionFile(const FString& FileName, const TSharedRef<FDynamicClassGenerationContext>& Context, const TSharedPtr<FSuzieDumpSignature>& Signature)
+{
+    FLoadedJsonClassDefinitionFile& LoadedFile = LoadedDefinitionFiles.FindOrAdd(FileName);
+    // Signatures are only needed to find out what has changed once the file is reloaded
+    LoadedFile.Signature = Signature;
+    LoadedFile.LazyGenerationContext.Reset();
+    if (CVarSuzieLazyClassGeneration.GetValueOnGameThread())
+    {
+        LoadedFile.LazyGenerationContext = Context;
+    }
+}
+
+bool FSuziePluginModule::IsHotReloadEnabled()
+{
+    return GIsEditor && !IsRunningCommandlet() && CVarSuzieHotReload.GetValueOnGameThread();
+}
+
+void FSuziePluginModule::StartWatchingJsonClassDefinitions()
+{
+    const FString JsonClassesPath = GetJsonClassDefinitionDirectory();
+    if (!FPlatformFileManager::Get().GetPlatformFile().DirectoryExists(*JsonClassesPath))
+    {
+        return;
+    }
+    FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+    if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get())
+    {
+        DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(JsonClassesPath,
+            IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FSuziePluginModule::OnJsonClassDefinitionDirectoryChanged),
+            DirectoryChangedDelegateHandle);
+        UE_LOG(LogSuzie, Display, TEXT("Watching %s for class definition changes"), *JsonClassesPath);
+    }
+}
+
+void FSuziePluginModule::StopWatchingJsonClassDefinitions()
+{
+    if (HotReloadTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(HotReloadTickerHandle);
+        HotReloadTickerHandle.Reset();
+    }
+    if (DirectoryChangedDelegateHandle.IsValid())
+    {
+        if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+        {
+            if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+            {
+                DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(GetJsonClassDefinitionDirectory(), DirectoryChangedDelegateHandle);
+            }
+        }
+        DirectoryChangedDelegateHandle.Reset();
+    }
+    PendingHotReloadFiles.Empty();
+}
+
+void FSuziePluginModule::OnJsonClassDefinitionDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+    for (const FFileChangeData& FileChange : FileChanges)
+    {
+        // Removed files are ignored, since generated objects cannot be removed anyway. Shards of sharded dumps are not reloaded either
+        const FString FileName = FPaths::GetCleanFilename(FileChange.Filename);
+        EJsonClassDefinitionCompression Compression;
+        if (FileChange.Action == FFileChangeData::FCA_Removed || !GetJsonClassDefinitionFileCompression(FileName, Compression) ||
+            !FPaths::IsSamePath(FPaths::GetPath(FileChange.Filename), GetJsonClassDefinitionDirectory()))
+        {
+            continue;
+        }
+        // Dumps are large and are usually written in multiple chunks, so wait until the file has not changed for a bit before reloading it
+        PendingHotReloadFiles.Add(FileName, FPlatformTime::Seconds());
+    }
+    if (!PendingHotReloadFiles.IsEmpty() && !HotReloadTickerHandle.IsValid())
+    {
+        HotReloadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSuziePluginModule::TickPendingHotReloads), 0.5f);
+    }
+}
+
+bool FSuziePluginModule::TickPendingHotReloads(float DeltaTime)
+{
+    constexpr double HotReloadSettleTime = 2.0;
+    const double CurrentTime = FPlatformTime::Seconds();
+
+    TArray<FString> SettledFileNames;
+    for (const TPair<FString, double>& PendingFile : PendingHotReloadFiles)
+    {
+        if (CurrentTime - PendingFile.Value >= HotReloadSettleTime)
+        {
+            SettledFileNames.Add(PendingFile.Key);
+        }
+    }
+    for (const FString& FileName : SettledFileNames)
+    {
+        PendingHotReloadFiles.Remove(FileName);
+        HotReloadJsonClassDefinitionFile(FileName);
+    }
+
+    // Keep ticking while there are files waiting to settle
+    if (PendingHotReloadFiles.IsEmpty())
+    {
+        HotReloadTickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FSuziePluginModule::HotReloadJsonClassDefinitionFile(const FString& FileName)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(Suzie_HotReloadJsonClassDefinitionFile);
+    FSuzieGenerationStats::Get().BeginRun();
+    const double StartTime = FPlatformTime::Seconds();
+    UE_LOG(LogSuzie, Display, TEXT("Class definition file changed, reloading: %s"), *FileName);
+
+    EJsonClassDefinitionCompression Compression = EJsonClassDefinitionCompression::None;
+    GetJsonClassDefinitionFileCompression(FileName, Compression);
+    const TSharedPtr<FDynamicClassGenerationContext> Context = LoadJsonClassDefinitionFile(GetJsonClassDefinitionDirectory() / FileName, Compression);
+    if (!Context.IsValid())
+    {
+        // Errors have already been reported. The file might still be in the process of being written, in which case it will be reloaded again once it is complete
         return;
     }
 
-    // Create class generation context
-    FDynamicClassGenerationContext ClassGenerationContext;
-    ClassGenerationContext.GlobalObjectMap = *Objects;
+    // Objects are only ever added. Objects that have been removed from the dump are kept, and objects that have changed are kept as they are
+    const FLoadedJsonClassDefinitionFile* PreviousFile = LoadedDefinitionFiles.Find(FileName);
+    const FSuzieDumpSignature* PreviousSignature = PreviousFile ? PreviousFile->Signature.Get() : nullptr;
+    const TSharedRef<FSuzieDumpSignature> NewSignature = MakeShared<FSuzieDumpSignature>(FSuzieDumpSignature::Create(*Context));
+    const FSuzieDumpDiff Diff = FSuzieDumpDiff::Compare(PreviousSignature ? *PreviousSignature : FSuzieDumpSignature(), *NewSignature);
+
+    TArray<int32> NewRecordIndices;
+    TSet<int32> ExistingClassRecordIndices;
+    for (const FSuzieObjectDiff& ObjectDiff : Diff.Objects)
+    {
+        if (ObjectDiff.Changes == ESuzieObjectChange::Added)
+        {
+            const FDynamicObjectRecord* ObjectRecord = Context->FindObjectRecord(ObjectDiff.ObjectPath);
+            NewRecordIndices.Add(UE_PTRDIFF_TO_INT32(ObjectRecord - Context->ObjectRecords.GetData()));
+
+            // New functions of classes that already exist are added to them below. Without a previous signature the file is new, and so are its classes
+            const FDynamicObjectRecord* OuterRecord = ObjectRecord->Type == EDynamicObjectType::Function ? Context->FindObjectRecord(ObjectRecord->OuterPath) : nullptr;
+            if (OuterRecord && OuterRecord->Type == EDynamicObjectType::Class && PreviousSignature && PreviousSignature->Objects.Contains(OuterRecord->ObjectPath))
+            {
+                ExistingClassRecordIndices.Add(UE_PTRDIFF_TO_INT32(OuterRecord - Context->ObjectRecords.GetData()));
+            }
+        }
+        else if (ObjectDiff.Changes != ESuzieObjectChange::Removed)
+        {
+            UE_LOG(LogSuzie, Warning, TEXT("%s %s has changed. Existing objects cannot be changed, restart the editor to pick up the change"),
+                FSuzieDumpDiff::GetObjectTypeName(ObjectDiff.Type), *ObjectDiff.ObjectPath.ToString());
+        }
+    }
+
+    if (CVarSuzieLazyClassGeneration.GetValueOnGameThread())
+    {
+        // Swap the context of the file for the new one. Classes will be generated from it once something references them
+        if (PreviousFile && PreviousFile->LazyGenerationContext.IsValid())
+        {
+            LazyGenerationContexts.Remove(PreviousFile->LazyGenerationContext);
+        }
+        LazyGenerationContexts.Add(Context);
+    }
+    else
+    {
+        // Create the new objects. Their dependencies are either new as well, or already exist
+        for (const int32 RecordIndex : NewRecordIndices)
+        {
+            CreateDynamicObjectForRecord(*Context, Context->ObjectRecords[RecordIndex]);
+        }
+
+        // Functions do not affect the layout of the class, so new functions can be added to the existing classes
+        for (const int32 RecordIndex : ExistingClassRecordIndices)
+        {
+            const FDynamicObjectRecord& ClassRecord = Context->ObjectRecords[RecordIndex];
+            UClass* ExistingClass = FindObject<UClass>(nullptr, *ClassRecord.ObjectPath.ToString());
+            // Only dynamic classes that have been fully generated can be extended
+            const bool bIsDynamicClass = ExistingClass && ExistingClass->ClassConstructor == &FSuziePluginModule::PolymorphicClassConstructorInvocationHelper && ExistingClass->HasAnyClassFlags(CLASS_Native);
+            if (!bIsDynamicClass || GetFlattenedConstructionData(ExistingClass) == nullptr)
+            {
+                continue;
+            }
+            for (const int32 ChildRecordIndex : ClassRecord.Children)
+            {
+                const FDynamicObjectRecord& ChildRecord = Context->ObjectRecords[ChildRecordIndex];
+                if (ChildRecord.Type == EDynamicObjectType::Function && FindObjectFast<UFunction>(ExistingClass, ChildRecord.ObjectName) == nullptr)
+                {
+                    AddFunctionToClass(*Context, ExistingClass, ChildRecord.ObjectPath.ToString());
+                }
+            }
+        }
+        ConstructAndFinalizePendingClasses(*Context);
+    }
+    RegisterLoadedDefinitionFile(FileName, Context.ToSharedRef(), NewSignature);
+    if (!CVarSuzieLazyClassGeneration.GetValueOnGameThread())
+    {
+        Context->ReleaseDefinitions();
+    }
+    UE_LOG(LogSuzie, Verbose, TEXT("Changes of %s:\n%s"), *FileName, *Diff.CreateReport());
+
+    UE_LOG(LogSuzie, Display, TEXT("Reloaded %s in %.2f seconds: %d new objects, %d changed objects that require a restart, %d unchanged objects"),
+        *FileName, FPlatformTime::Seconds() - StartTime, NewRecordIndices.Num(), Diff.GetNumRequiringRestart(), Diff.NumUnchanged);
+    FSuzieGenerationStats::Get().LogSummary(FString::Printf(TEXT("Hot reload of %s"), *FileName));
+}
+
+void FSuziePluginModule::ConstructAndFinalizePendingClasses(FDynamicClassGenerationContext& Context)
+{
+    // Construct classes that have been created but have not been constructed yet due to nobody referencing them
+    while (!Context.ClassesPendingConstruction.IsEmpty())
+    {
+        TArray<FString> ClassPathsPendingConstruction;
+        Context.ClassesPendingConstruction.GenerateValueArray(ClassPathsPendingConstruction);
+        for (const FString& ClassPath : ClassPathsPendingConstruction)
+        {
+            FindOrCreateClass(Context, ClassPath);
+        }
+    }
+
+    // Finalize all classes that we have created now. This includes assembling reference streams, creating default subobjects and populating them with data
+    FinalizePendingClasses(Context);
+}
+
+UClass* FSuziePluginModule::ResolveDynamicClass(const FString& ClassPath)
+{
+    if (ClassPath.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    // Find the context that has the definition of the class. Classes are only ever defined by a single file
+    for (const TSharedPtr<FDynamicClassGenerationContext>& Context : LazyGenerationContexts)
+    {
+        const FDynamicObjectRecord* ClassRecord = Context->FindObjectRecord(ClassPath);
+        if (ClassRecord == nullptr || ClassRecord->Type != EDynamicObjectType::Class)
+        {
+            continue;
+        }
+
+        // Class might have already been generated as a dependency of another class
+        UClass* ExistingClass = FindObject<UClass>(nullptr, *ClassPath);
+        if (ExistingClass && !Context->ClassesPendingConstruction.Contains(ExistingClass))
+        {
+            return ExistingClass;
+        }
+
+        UE_LOG(LogSuzie, Verbose, TEXT("Lazily creating class %s"), *ClassPath);
+        UClass* NewClass = FindOrCreateClass(*Context, ClassPath);
+
+        // Construct and finalize the class along with all of the classes it has pulled in as dependencies
+        ConstructAndFinalizePendingClasses(*Context);
+        return NewClass;
+    }
+
+    // Class might be defined by a shard that has not been loaded yet
+    if (LoadShardForObjectPath(ClassPath))
+    {
+        return ResolveDynamicClass(ClassPath);
+    }
+
+    // This is not a class from the dump, but it might still be a native class or a class that has been generated eagerly
+    return FindObject<UClass>(nullptr, *ClassPath);
+}
+
+void FSuziePluginModule::GenerateLazyRootClasses()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(Suzie_GenerateLazyRootClasses);
+    FSuzieGenerationStats::Get().BeginRun();
+
+    // Explicitly listed classes are always generated, even if no asset references them
+    TArray<FString> RootClassPaths;
+    GConfig->GetArray(TEXT("Suzie"), TEXT("LazyGenerationRootClasses"), RootClassPaths, GEngineIni);
+    for (const FString& RootClassPath : RootClassPaths)
+    {
+        ResolveDynamicClass(RootClassPath);
+    }
+
+    // Assets can only be loaded if their classes and the classes they are derived from exist, so wait for the asset registry to discover all of them
+    IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+    AssetRegistry.SearchAllAssets(true);
+
+    TArray<FAssetData> AllAssets;
+    AssetRegistry.GetAllAssets(AllAssets, true);
+    for (const FAssetData& AssetData : AllAssets)
+    {
+        ResolveAssetClassDependencies(AssetData);
+    }
+
+    // Assets added after the initial scan (e.g. by a source control sync) might reference classes that have not been generated yet
+    OnAssetAddedDelegateHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FSuziePluginModule::ResolveAssetClassDependencies);
 
-    // Create classes, script structs and global delegate functions
-    for (auto It = (*Objects)->Values.CreateConstIterator(); It; ++It)
-    {
-        FString ObjectPath = It.Key();
-        FString Type = It.Value()->AsObject()->GetStringField(TEXT("type"));
-        if (Type == TEXT("Class"))
-        {
-            // Meatloaf bug (commit d8179e8): CDOs of UClass-derived native classes will be labeled with Class type, instead of "Object" type, which will result in a crash
-            // down the line due to the CDO being created with the wrong class type
-            FString PackageName;
-            FString ClassName;
-            ParseObjectPath(ObjectPath, PackageName, ClassName);
-            if (ClassName.StartsWith(TEXT("Default__")))
+    int32 TotalClassCount = 0;
+    int32 GeneratedClassCount = 0;
+    for (const TSharedPtr<FDynamicClassGenerationContext>& Context : LazyGenerationContexts)
+    {
+        for (const FDynamicObjectRecord& ObjectRecord : Context->ObjectRecords)
+        {
+            if (ObjectRecord.Type == EDynamicObjectType::Class)
             {
-                continue;
+                TotalClassCount++;
+                GeneratedClassCount += FindObject<UClass>(nullptr, *ObjectRecord.ObjectPath.ToString()) != nullptr;
             }
-            UE_LOG(LogSuzie, Verbose, TEXT("Creating class %s"), *ObjectPath);
-            FindOrCreateClass(ClassGenerationContext, ObjectPath);
-        }
-        else if (Type == TEXT("ScriptStruct"))
-        {
-            UE_LOG(LogSuzie, Verbose, TEXT("Creating struct %s"), *ObjectPath);
-            FindOrCreateScriptStruct(ClassGenerationContext, ObjectPath);
-        }
-        else if (Type == TEXT("Enum"))
-        {
-            UE_LOG(LogSuzie, Verbose, TEXT("Creating enum %s"), *ObjectPath);
-            FindOrCreateEnum(ClassGenerationContext, ObjectPath);
-        }
-        else if (Type == TEXT("Function"))
-        {
-            UE_LOG(LogSuzie, VeryVerbose, TEXT("Creating function %s"), *ObjectPath);
-            FindOrCreateFunction(ClassGenerationContext, ObjectPath);
         }
     }
+    UE_LOG(LogSuzie, Display, TEXT("Lazy class generation created %d out of %d dynamic classes"), GeneratedClassCount, TotalClassCount);
+    FSuzieGenerationStats::Get().LogSummary(TEXT("Lazy root class generation"));
+}
 
-    // Construct classes that have been created but have not been constructed yet due to nobody referencing them
-    while (!ClassGenerationContext.ClassesPendingConstruction.IsEmpty())
+void FSuziePluginModule::ResolveAssetClassDependencies(const FAssetData& AssetData)
+{
+    // Class of the asset itself (e.g. data assets of dynamic types)
+    ResolveDynamicClass(AssetData.AssetClassPath.ToString());
+
+    // Blueprint assets additionally reference their parent class and the native class they are ultimately derived from
+    for (const FName& ParentClassTagName : {FBlueprintTags::ParentClassPath, FBlueprintTags::NativeParentClassPath})
     {
-        TArray<FString> ClassPathsPendingConstruction;
-        ClassGenerationContext.ClassesPendingConstruction.GenerateValueArray(ClassPathsPendingConstruction);
-        for (const FString& ClassPath : ClassPathsPendingConstruction)
+        FString ParentClassExportPath;
+        if (AssetData.GetTagValue(ParentClassTagName, ParentClassExportPath))
         {
-            FindOrCreateClass(ClassGenerationContext, ClassPath);
+            ResolveDynamicClass(FPackageName::ExportTextPathToObjectPath(ParentClassExportPath));
         }
     }
-
-    // Finalize all classes that we have created now. This includes assembling reference streams, creating default subobjects and populating them with data
-    TArray<UClass*> ClassesPendingFinalization;
-    ClassGenerationContext.ClassesPendingFinalization.GenerateKeyArray(ClassesPendingFinalization);
-    for (UClass* ClassPendingFinalization : ClassesPendingFinalization)
-    {
-        FinalizeClass(ClassGenerationContext, ClassPendingFinalization);
-    }
 }
 
 UPackage* FSuziePluginModule::FindOrCreatePackage(FDynamicClassGenerationContext& Context, const FString& PackageName)
@@ -234,10 +1182,47 @@ UClass* FSuziePluginModule::GetPlaceholderNonNativePropertyOwnerClass()
     return PlaceholderNonNativeOwnerClass;
 }
 
+// Dynamic classes are allocated with extra space for the pointer to their flattened construction data
+using FFlattenedConstructionDataSlot = std::atomic<const FDynamicClassFlattenedConstructionData*>;
+static constexpr SIZE_T DynamicClassFlattenedConstructionDataOffset = Align(sizeof(UClass), alignof(FFlattenedConstructionDataSlot));
+static constexpr SIZE_T DynamicClassAllocationSize = DynamicClassFlattenedConstructionDataOffset + sizeof(FFlattenedConstructionDataSlot);
+
+static FFlattenedConstructionDataSlot& GetFlattenedConstructionDataSlot(const UClass* DynamicClass)
+{
+    return *reinterpret_cast<FFlattenedConstructionDataSlot*>(reinterpret_cast<UPTRINT>(DynamicClass) + DynamicClassFlattenedConstructionDataOffset);
+}
+
+// Finds an existing object by its path. Objects in packages are found by their names split by the name table of the context, without parsing the path again
+template<typename ObjectType>
+static ObjectType* FindObjectByPath(FDynamicClassGenerationContext& Context, const FString& ObjectPath)
+{
+    const FSuzieObjectPathNames PathNames = Context.NameTable->SplitObjectPath(ObjectPath);
+    if (!PathNames.bOuterIsPackage)
+    {
+        return FindObject<ObjectType>(nullptr, *ObjectPath);
+    }
+    UPackage* Package = FindObjectFast<UPackage>(nullptr, PathNames.OuterPath);
+    return Package ? FindObjectFast<ObjectType>(Package, PathNames.ObjectName) : nullptr;
+}
+
+// Bytes lost to alignment between the properties declared by the struct itself and at the end of the struct
+static int32 GetPropertyPaddingSize(const UStruct* Struct)
+{
+    const UStruct* SuperStruct = Struct->GetSuperStruct();
+    int32 PreviousPropertyEnd = SuperStruct ? SuperStruct->GetPropertiesSize() : 0;
+    int32 PaddingSize = 0;
+    for (TFieldIterator<FProperty> PropertyIterator(Struct, EFieldIterationFlags::None); PropertyIterator; ++PropertyIterator)
+    {
+        PaddingSize += FMath::Max(PropertyIterator->GetOffset_ForInternal() - PreviousPropertyEnd, 0);
+        PreviousPropertyEnd = FMath::Max(PreviousPropertyEnd, PropertyIterator->GetOffset_ForInternal() + PropertyIterator->GetSize());
+    }
+    return PaddingSize + FMath::Max(Struct->GetStructureSize() - PreviousPropertyEnd, 0);
+}
+
 UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGenerationContext& Context, const FString& ClassPath)
 {
     // Attempt to find an existing class first
-    if (UClass* ExistingClass = FindObject<UClass>(nullptr, *ClassPath))
+    if (UClass* ExistingClass = FindObjectByPath<UClass>(Context, ClassPath))
     {
         return ExistingClass;
     }
@@ -248,16 +1233,15 @@ UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGeneratio
         return nullptr;
     }
     Context.UnregisteredDynamicClassConstructionStack.Add(ClassPath);
+    SUZIE_SCOPED_PHASE(ClassCreation);
     
-    const TSharedPtr<FJsonObject> ClassDefinition = Context.GlobalObjectMap->GetObjectField(ClassPath);
-    checkf(ClassDefinition.IsValid(), TEXT("Failed to find class object by path %s"), *ClassPath);
-    
-    const FString ObjectType = ClassDefinition->GetStringField(TEXT("type"));
-    checkf(ObjectType == TEXT("Class"), TEXT("FindOrCreateUnregisteredClass expected Class object %s, got object of type %s"), *ClassPath, *ObjectType);
+    const FDynamicObjectRecord* ClassRecord = Context.FindObjectRecord(ClassPath);
+    checkf(ClassRecord, TEXT("Failed to find class object by path %s"), *ClassPath);
+    checkf(ClassRecord->Type == EDynamicObjectType::Class, TEXT("FindOrCreateUnregisteredClass expected Class object %s, got object of type %d"), *ClassPath, (int32)ClassRecord->Type);
 
     // Meatloaf bug (commit d8179e8): UClass-derived native classes will produce Null super_struct, which will crash Suzie down the line
     // Attempt to recover by assuming UClass parent in this case for this class
-    const FString ParentClassPath = ClassDefinition->GetStringField(TEXT("super_struct"));
+    const FString ParentClassPath = ClassRecord->SuperStructPath.IsNone() ? FString() : ClassRecord->SuperStructPath.ToString();
     UClass* ParentClass = ParentClassPath.IsEmpty() ? UClass::StaticClass() : FindOrCreateClass(Context, ParentClassPath);
     if (!ParentClass)
     {
@@ -265,34 +1249,14 @@ UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGeneratio
         return nullptr;
     }
     
-    FString PackageName;
-    FString ClassName;
-    ParseObjectPath(ClassPath, PackageName, ClassName);
+    const FString PackageName = ClassRecord->OuterPath.ToString();
+    const FString ClassName = ClassRecord->ObjectName.ToString();
 
     // DeferredRegister for UClass will automatically find the package by name, but we should still prime it before that
     FindOrCreatePackage(Context, PackageName);
 
-    // Note that only flags that are set manually (e.g. non-computed flags) should be listed here
-    static const TArray<TPair<FString, EClassFlags>> ClassFlagNameLookup = {
-        {TEXT("CLASS_Abstract"), CLASS_Abstract},
-        {TEXT("CLASS_EditInlineNew"), CLASS_EditInlineNew},
-        {TEXT("CLASS_NotPlaceable"), CLASS_NotPlaceable},
-        {TEXT("CLASS_CollapseCategories"), CLASS_CollapseCategories},
-        {TEXT("CLASS_Const"), CLASS_Const},
-        {TEXT("CLASS_DefaultToInstanced"), CLASS_DefaultToInstanced},
-        {TEXT("CLASS_Interface"), CLASS_Interface},
-    };
-
-    // Convert class flag names to the class flags bitmask
-    EClassFlags ClassFlags = CLASS_Native | CLASS_Intrinsic;
-    const TSet<FString> ClassFlagNames = ParseFlags(ClassDefinition->GetStringField(TEXT("class_flags")));
-    for (const auto& [ClassFlagName, ClassFlagBit] : ClassFlagNameLookup)
-    {
-        if (ClassFlagNames.Contains(ClassFlagName))
-        {
-            ClassFlags |= ClassFlagBit;
-        }
-    }
+    // Dynamic classes pretend to be native classes so that the engine does not attempt to load them from disk
+    const EClassFlags ClassFlags = CLASS_Native | CLASS_Intrinsic | ClassRecord->ClassFlags;
     
     // UE does not provide a copy constructor for that type, but it is a very much memcpy-able POD type
     FUObjectCppClassStaticFunctions ClassStaticFunctions;
@@ -300,7 +1264,8 @@ UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGeneratio
     
     //Code below is taken from GetPrivateStaticClassBody
     //Allocate memory from ObjectAllocator for class object and call class constructor directly
-    UClass* ConstructedClassObject = static_cast<UClass*>(GUObjectAllocator.AllocateUObject(sizeof(UClass), alignof(UClass), true));
+    //Memory right after the class object holds the pointer to the flattened construction data, see GetFlattenedConstructionData
+    UClass* ConstructedClassObject = static_cast<UClass*>(GUObjectAllocator.AllocateUObject(DynamicClassAllocationSize, alignof(UClass), true));
     ::new (ConstructedClassObject)UClass(
         EC_StaticConstructor,
         *ClassName,
@@ -313,6 +1278,7 @@ UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGeneratio
         &FSuziePluginModule::PolymorphicClassConstructorInvocationHelper,
         ParentClass->ClassVTableHelperCtorCaller,
         MoveTemp(ClassStaticFunctions));
+    new (&GetFlattenedConstructionDataSlot(ConstructedClassObject)) FFlattenedConstructionDataSlot(nullptr);
 
     //Set super structure and ClassWithin (they are required prior to registering)
     ConstructedClassObject->SetSuperStruct(ParentClass);
@@ -332,6 +1298,7 @@ UClass* FSuziePluginModule::FindOrCreateUnregisteredClass(FDynamicClassGeneratio
 
     Context.ClassesPendingConstruction.Add(ConstructedClassObject, ClassPath);
     Context.UnregisteredDynamicClassConstructionStack.Remove(ClassPath);
+    SUZIE_INCREMENT_COUNTER(Classes);
     
     UE_LOG(LogSuzie, Verbose, TEXT("Created dynamic class: %s"), *ClassPath);
     return ConstructedClassObject;
@@ -395,14 +1362,16 @@ public:
 #endif
 };
 
-// Note that new objects can be created from other threads, but we only touch this map when creating dynamic classes,
-// so we do not need an explicit mutex to guard the access to it during class initialization
-static TMap<UClass*, FDynamicClassConstructionData> DynamicClassConstructionData;
+// Owns the flattened construction data referenced from the dynamic class objects, including the data that has been replaced by a newer copy
+// Objects can be constructed from other threads while the data is being replaced, and dynamic classes outlive the module (e.g. objects are still
+// constructed and destroyed during engine shutdown), so the data is never released before the process exits
+// Only modified on the game thread during class generation
+static TArray<TPair<UClass*, TUniquePtr<FDynamicClassFlattenedConstructionData>>> PublishedFlattenedConstructionData;
 
 UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Context, const FString& ClassPath)
 {
     // Return existing class if exists
-    UClass* NewClass = FindObject<UClass>(nullptr, *ClassPath);
+    UClass* NewClass = FindObjectByPath<UClass>(Context, ClassPath);
 
     // If class already exists and is not pending constructed, we do not need to do anything
     if (NewClass && !Context.ClassesPendingConstruction.Contains(NewClass))
@@ -423,50 +1392,39 @@ UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Co
 
     // Remove the class from the pending construction set to prevent possible re-entry
     Context.ClassesPendingConstruction.Remove(NewClass);
+    SUZIE_SCOPED_PHASE(ClassCreation);
 
-    const TSharedPtr<FJsonObject> ClassDefinition = Context.GlobalObjectMap->GetObjectField(ClassPath);
+    const FDynamicObjectRecord* ClassRecord = Context.FindObjectRecord(ClassPath);
+    checkf(ClassRecord, TEXT("Failed to find class object by path %s"), *ClassPath);
 
     TArray<const FProperty*> PropertiesWithDestructor;
     TArray<const FProperty*> PropertiesWithConstructor;
-    FArchive EmptyPropertyLinkArchive;
 
-    // Add properties to the class
-    const TArray<TSharedPtr<FJsonValue>>& Properties = ClassDefinition->GetArrayField(TEXT("properties"));
-    for (const TSharedPtr<FJsonValue>& PropertyDescriptor : Properties)
+    // Add properties to the class. We want all properties to be editable, visible and blueprint assignable
+    const EPropertyFlags ExtraPropertyFlags = CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintAssignable;
+    const TArray<FProperty*> CreatedProperties = AddPropertiesToStruct(Context, NewClass, ClassRecord->Definition->GetArrayField(TEXT("properties")), ExtraPropertyFlags, true);
+    LayoutNativeClassProperties(NewClass, CreatedProperties);
+
+    // Add properties into the constructor/destructor lists based on their flags
+    for (const FProperty* CreatedProperty : CreatedProperties)
     {
-        // We want all properties to be editable, visible and blueprint assignable
-        const EPropertyFlags ExtraPropertyFlags = CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintAssignable;
-        if (FProperty* CreatedProperty = AddPropertyToStruct(Context, NewClass, PropertyDescriptor->AsObject(), ExtraPropertyFlags))
+        if (!CreatedProperty->HasAnyPropertyFlags(CPF_IsPlainOldData | CPF_NoDestructor))
         {
-            // Because this is a native class, we have to link the property offset manually here rather than expecting StaticLink to do it for us
-            NewClass->PropertiesSize = CreatedProperty->Link(EmptyPropertyLinkArchive);
-            NewClass->MinAlignment = FMath::Max(NewClass->MinAlignment, CreatedProperty->GetMinAlignment());
-#if (ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5)
-            // Added in 5.5, needs to be incremented for each new property added to the class
-            NewClass->TotalFieldCount++;
-#endif
-
-            // Add property into the constructor/destructor lists based on its flags
-            if (!CreatedProperty->HasAnyPropertyFlags(CPF_IsPlainOldData | CPF_NoDestructor))
-            {
-                PropertiesWithDestructor.Add(CreatedProperty);
-            }
-            if (!CreatedProperty->HasAnyPropertyFlags(CPF_ZeroConstructor))
-            {
-                PropertiesWithConstructor.Add(CreatedProperty);
-            }
+            PropertiesWithDestructor.Add(CreatedProperty);
+        }
+        if (!CreatedProperty->HasAnyPropertyFlags(CPF_ZeroConstructor))
+        {
+            PropertiesWithConstructor.Add(CreatedProperty);
         }
     }
 
     // Add functions to the class
-    const TArray<TSharedPtr<FJsonValue>>& Children = ClassDefinition->GetArrayField(TEXT("children"));
-    for (const TSharedPtr<FJsonValue>& FunctionObjectPathValue : Children)
+    for (const int32 ChildRecordIndex : ClassRecord->Children)
     {
-        FString ChildPath = FunctionObjectPathValue->AsString();
-        const TSharedPtr<FJsonObject> ChildObject = Context.GlobalObjectMap->GetObjectField(ChildPath);
-        if (ChildObject && ChildObject->GetStringField(TEXT("type")) == TEXT("Function"))
+        const FDynamicObjectRecord& ChildRecord = Context.ObjectRecords[ChildRecordIndex];
+        if (ChildRecord.Type == EDynamicObjectType::Function)
         {
-            AddFunctionToClass(Context, NewClass, ChildPath);
+            AddFunctionToClass(Context, NewClass, ChildRecord.ObjectPath.ToString());
         }
     }
 
@@ -480,8 +1438,12 @@ UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Co
     }
 
     // Bind parent class to this class and link properties to calculate their runtime derived data
-    NewClass->Bind();
-    NewClass->StaticLink();
+    {
+        SUZIE_SCOPED_PHASE(StaticLink);
+        NewClass->Bind();
+        NewClass->StaticLink();
+    }
+    SUZIE_INCREMENT_COUNTER(PropertyPaddingBytes, GetPropertyPaddingSize(NewClass));
     NewClass->SetSparseClassDataStruct(NewClass->GetSparseClassDataArchetypeStruct());
 
     // If we have properties that need destructor call, we add a synthetic property of custom type to DestructorLink
@@ -493,13 +1455,15 @@ UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Co
     }
 
     // Stash the properties that need to be constructed on the class data so polymorphic constructor can access them easily
-    FDynamicClassConstructionData& ClassConstructionData = DynamicClassConstructionData.FindOrAdd(NewClass);
+    FDynamicClassConstructionData& ClassConstructionData = Context.ClassConstructionData.FindOrAdd(NewClass);
     ClassConstructionData.PropertiesToConstruct = PropertiesWithConstructor;
 
-    const FString ClassDefaultObjectPath = ClassDefinition->GetStringField(TEXT("class_default_object"));
-    
+    // Publish provisional construction data right away, so that objects of this class constructed before it is finalized still have their properties constructed
+    // Default subobjects are only known once the class is finalized, which publishes the complete data
+    PublishFlattenedConstructionData(NewClass, AssembleFlattenedConstructionData(Context, ClassConstructionData, NewClass, TSet<FName>()));
+
     // Class default object can be created at this point
-    Context.ClassesPendingFinalization.Add(NewClass, ClassDefaultObjectPath);
+    Context.ClassesPendingFinalization.Add(NewClass, ClassRecord->ClassDefaultObjectPath);
     
     return NewClass;
 }
@@ -507,22 +1471,21 @@ UClass* FSuziePluginModule::FindOrCreateClass(FDynamicClassGenerationContext& Co
 UScriptStruct* FSuziePluginModule::FindOrCreateScriptStruct(FDynamicClassGenerationContext& Context, const FString& StructPath)
 {
     // Check if we have already created this struct
-    if (UScriptStruct* ExistingScriptStruct = FindObject<UScriptStruct>(nullptr, *StructPath))
+    if (UScriptStruct* ExistingScriptStruct = FindObjectByPath<UScriptStruct>(Context, StructPath))
     {
         return ExistingScriptStruct;
     }
 
-    const TSharedPtr<FJsonObject> StructDefinition = Context.GlobalObjectMap->GetObjectField(StructPath);
-    checkf(StructDefinition.IsValid(), TEXT("Failed to find script struct object by path %s"), *StructPath);
-    
-    const FString ObjectType = StructDefinition->GetStringField(TEXT("type"));
-    checkf(ObjectType == TEXT("ScriptStruct"), TEXT("FindOrCreateScriptStruct expected ScriptStruct object %s, got object of type %s"), *StructPath, *ObjectType);
+    const FDynamicObjectRecord* StructRecord = Context.FindObjectRecord(StructPath);
+    checkf(StructRecord, TEXT("Failed to find script struct object by path %s"), *StructPath);
+    checkf(StructRecord->Type == EDynamicObjectType::ScriptStruct, TEXT("FindOrCreateScriptStruct expected ScriptStruct object %s, got object of type %d"), *StructPath, (int32)StructRecord->Type);
+    SUZIE_SCOPED_PHASE(StructCreation);
 
     // Resolve parent struct for this struct before we attempt to create this struct
     UScriptStruct* SuperScriptStruct = nullptr;
-    FString ParentStructPath;
-    if (StructDefinition->TryGetStringField(TEXT("super_struct"), ParentStructPath))
+    if (!StructRecord->SuperStructPath.IsNone())
     {
+        const FString ParentStructPath = StructRecord->SuperStructPath.ToString();
         SuperScriptStruct = FindOrCreateScriptStruct(Context, ParentStructPath);
         if (SuperScriptStruct == nullptr)
         {
@@ -531,9 +1494,8 @@ UScriptStruct* FSuziePluginModule::FindOrCreateScriptStruct(FDynamicClassGenerat
         }
     }
     
-    FString PackageName;
-    FString ObjectName;
-    ParseObjectPath(StructPath, PackageName, ObjectName);
+    const FString PackageName = StructRecord->OuterPath.ToString();
+    const FString ObjectName = StructRecord->ObjectName.ToString();
 
     // Create a package for the struct or reuse the existing package. Make sure it's marked as Native package
     UPackage* Package = FindOrCreatePackage(Context, PackageName);
@@ -547,38 +1509,22 @@ UScriptStruct* FSuziePluginModule::FindOrCreateScriptStruct(FDynamicClassGenerat
         NewStruct->StructFlags = (EStructFlags) ((int32)NewStruct->StructFlags | (SuperScriptStruct->StructFlags & STRUCT_Inherit));
     }
 
-    // Note that only flags that are set manually (e.g. non-computed flags) should be listed here
-    static const TArray<TPair<FString, EStructFlags>> StructFlagNameLookup = {
-        {TEXT("STRUCT_Atomic"), STRUCT_Atomic},
-        {TEXT("STRUCT_Immutable"), STRUCT_Immutable},
-    };
-
-    // Convert struct flag names to the struct flags bitmask
-    const TSet<FString> StructFlagNames = ParseFlags(StructDefinition->GetStringField(TEXT("struct_flags")));
-    for (const auto& [StructFlagName, StructFlagBit] : StructFlagNameLookup)
-    {
-        if (StructFlagNames.Contains(StructFlagName))
-        {
-            NewStruct->StructFlags = (EStructFlags)((int32)NewStruct->StructFlags | StructFlagBit);
-        }
-    }
+    NewStruct->StructFlags = (EStructFlags)((int32)NewStruct->StructFlags | StructRecord->StructFlags);
 
-    // Initialize properties for the struct
-    TArray<TSharedPtr<FJsonValue>> Properties = StructDefinition->GetArrayField(TEXT("properties"));
-    for (const TSharedPtr<FJsonValue>& PropertyDescriptor : Properties)
-    {
-        // We want all properties to be editable, visible and blueprint assignable
-        const EPropertyFlags ExtraPropertyFlags = CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintAssignable;
-        AddPropertyToStruct(Context, NewStruct, PropertyDescriptor->AsObject(), ExtraPropertyFlags);
-    }
+    // Initialize properties for the struct. We want all properties to be editable, visible and blueprint assignable
+    const EPropertyFlags ExtraPropertyFlags = CPF_Edit | CPF_BlueprintVisible | CPF_BlueprintAssignable;
+    AddPropertiesToStruct(Context, NewStruct, StructRecord->Definition->GetArrayField(TEXT("properties")), ExtraPropertyFlags, true);
     
     // Mark all dynamic script structs as blueprint types
     NewStruct->SetMetaData(FBlueprintMetadata::MD_AllowableBlueprintVariableType, TEXT("true"));
 
     // Bind the newly created struct and link it to assign property offsets and calculate the size
-    NewStruct->Bind();
-    NewStruct->PrepareCppStructOps();
-    NewStruct->StaticLink(true);
+    {
+        SUZIE_SCOPED_PHASE(StaticLink);
+        NewStruct->Bind();
+        NewStruct->PrepareCppStructOps();
+        NewStruct->StaticLink(true);
+    }
 
     // The engine does not gracefully handle empty structs, so force the struct size to be at least one byte
     if (NewStruct->GetPropertiesSize() == 0)
@@ -586,7 +1532,9 @@ UScriptStruct* FSuziePluginModule::FindOrCreateScriptStruct(FDynamicClassGenerat
         NewStruct->MinAlignment = 1;
         NewStruct->SetPropertiesSize(1);
     }
+    SUZIE_INCREMENT_COUNTER(PropertyPaddingBytes, GetPropertyPaddingSize(NewStruct));
     
+    SUZIE_INCREMENT_COUNTER(ScriptStructs);
     UE_LOG(LogSuzie, Verbose, TEXT("Created struct: %s"), *ObjectName);
 
     // Struct properties using this struct can be created at this point
@@ -596,20 +1544,19 @@ UScriptStruct* FSuziePluginModule::FindOrCreateScriptStruct(FDynamicClassGenerat
 UEnum* FSuziePluginModule::FindOrCreateEnum(FDynamicClassGenerationContext& Context, const FString& EnumPath)
 {
     // Check if we have already created this enum
-    if (UEnum* ExistingEnum = FindObject<UEnum>(nullptr, *EnumPath))
+    if (UEnum* ExistingEnum = FindObjectByPath<UEnum>(Context, EnumPath))
     {
         return ExistingEnum;
     }
 
-    const TSharedPtr<FJsonObject> EnumDefinition = Context.GlobalObjectMap->GetObjectField(EnumPath);
-    checkf(EnumDefinition.IsValid(), TEXT("Failed to find enum object by path %s"), *EnumPath);
-    
-    const FString ObjectType = EnumDefinition->GetStringField(TEXT("type"));
-    checkf(ObjectType == TEXT("Enum"), TEXT("FindOrCreateEnum expected Enum object %s, got object of type %s"), *EnumPath, *ObjectType);
+    const FDynamicObjectRecord* EnumRecord = Context.FindObjectRecord(EnumPath);
+    checkf(EnumRecord, TEXT("Failed to find enum object by path %s"), *EnumPath);
+    checkf(EnumRecord->Type == EDynamicObjectType::Enum, TEXT("FindOrCreateEnum expected Enum object %s, got object of type %d"), *EnumPath, (int32)EnumRecord->Type);
+    SUZIE_SCOPED_PHASE(EnumCreation);
+    const TSharedPtr<FJsonObject>& EnumDefinition = EnumRecord->Definition;
 
-    FString PackageName;
-    FString ObjectName;
-    ParseObjectPath(EnumPath, PackageName, ObjectName);
+    const FString PackageName = EnumRecord->OuterPath.ToString();
+    const FString ObjectName = EnumRecord->ObjectName.ToString();
 
     // Create a package for the struct or reuse the existing package. Make sure it's marked as Native package
     UPackage* Package = FindOrCreatePackage(Context, PackageName);
@@ -648,6 +1595,7 @@ UEnum* FSuziePluginModule::FindOrCreateEnum(FDynamicClassGenerationContext& Cont
 
     // Mark all dynamic enums as blueprint types
     NewEnum->SetMetaData(*FBlueprintMetadata::MD_AllowableBlueprintVariableType.ToString(), TEXT("true"));
+    SUZIE_INCREMENT_COUNTER(Enums);
     
     UE_LOG(LogSuzie, Verbose, TEXT("Created enum: %s"), *ObjectName);
 
@@ -662,9 +1610,13 @@ UFunction* FSuziePluginModule::FindOrCreateFunction(FDynamicClassGenerationConte
         return ExistingFunction;
     }
     
-    FString ClassPathOrPackageName;
-    FString ObjectName;
-    ParseObjectPath(FunctionPath, ClassPathOrPackageName, ObjectName);
+    const FDynamicObjectRecord* FunctionRecord = Context.FindObjectRecord(FunctionPath);
+    checkf(FunctionRecord, TEXT("Failed to find function object by path %s"), *FunctionPath);
+    checkf(FunctionRecord->Type == EDynamicObjectType::Function, TEXT("FindOrCreateFunction expected Function object %s, got object of type %d"), *FunctionPath, (int32)FunctionRecord->Type);
+    SUZIE_SCOPED_PHASE(FunctionCreation);
+
+    const FString ClassPathOrPackageName = FunctionRecord->OuterPath.ToString();
+    const FString ObjectName = FunctionRecord->ObjectName.ToString();
 
     // Function can be outered either to a class or to a package, we can decide based on whenever there is a separator in the path
     UObject* FunctionOuterObject;
@@ -686,8 +1638,176 @@ UFunction* FSuziePluginModule::FindOrCreateFunction(FDynamicClassGenerationConte
         return ExistingFunction;
     }
 
+    // Have to temporarily mark the function as RF_ArchetypeObject to be able to create functions with UPackage as outer
+    UFunction* NewFunction = NewObject<UFunction>(FunctionOuterObject, *ObjectName, RF_Public | RF_MarkAsRootSet | RF_ArchetypeObject);
+    NewFunction->ClearFlags(RF_ArchetypeObject);
+    NewFunction->FunctionFlags |= FunctionRecord->FunctionFlags;
+
+    // Since this function is not marked as Native, we have to initialize Script bytecode for it
+    // Most basic valid kismet bytecode for a function would be EX_Return EX_Nothing EX_EndOfScript, so generate that
+    NewFunction->Script.Append({EX_Return, EX_Nothing, EX_EndOfScript});
+
+    // Create function parameter properties (and function return value property). Parameters are never reordered, since their order is the order of the arguments
+    AddPropertiesToStruct(Context, NewFunction, FunctionRecord->Definition->GetArrayField(TEXT("properties")));
+
+    // This function will always be linked as a last element of the list, so it has no next element
+    NewFunction->Next = nullptr;
+
+    // Bind the function and calculate property layout and function locals size
+    {
+        SUZIE_SCOPED_PHASE(StaticLink);
+        NewFunction->Bind();
+        NewFunction->StaticLink(true);
+    }
+    SUZIE_INCREMENT_COUNTER(Functions);
+
+    // Do some tagging of the function for convenience based on parameter types and names
+    for (TFieldIterator<FProperty> PropertyIterator(NewFunction); PropertyIterator; ++PropertyIterator)
+    {
+        const FProperty* Property = *PropertyIterator;
+        if (!Property->HasAllPropertyFlags(CPF_Parm) || Property->HasAnyPropertyFlags(CPF_ReturnParm)) continue;
+
+        // Object properties called WorldContext/WorldContextObject are automatically tagged as world context for convenience
+        if (Property->IsA<FObjectProperty>() && (Property->GetFName() == TEXT("WorldContext") || Property->GetFName() == TEXT("WorldContextObject")))
+        {
+            NewFunction->SetMetaData(FBlueprintMetadata::MD_WorldContext, *Property->GetName());
+        }
+        // Latent Info struct parameter properties should always be tagged as LatentInfo and indicate async BP functions
+        if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property); StructProperty && StructProperty->Struct == FLatentActionInfo::StaticStruct())
+        {
+            NewFunction->SetMetaData(FBlueprintMetadata::MD_LatentInfo, *Property->GetName());
+            NewFunction->SetMetaData(FBlueprintMetadata::MD_Latent, TEXT("true"));
+        }
+    }
+
+    UE_LOG(LogSuzie, VeryVerbose, TEXT("Created function %s in outer %s"), *ObjectName, *FunctionOuterObject->GetName());
+    return NewFunction;
+}
+
+void FSuziePluginModule::ParseObjectPath(const FStringView ObjectPath, FStringView& OutOuterObjectPath, FStringView& OutObjectName)
+{
+    int32 ObjectNameSeparatorIndex;
+    if (ObjectPath.FindLastChar(':', ObjectNameSeparatorIndex))
+    {
+        // There is a sub-object separator in the path name, string past it is the object name
+        OutOuterObjectPath = ObjectPath.Left(ObjectNameSeparatorIndex);
+        OutObjectName = ObjectPath.RightChop(ObjectNameSeparatorIndex + 1);
+    }
+    else if (ObjectPath.FindLastChar('.', ObjectNameSeparatorIndex))
+    {
+        // This is a top level object (or this is a legacy path), string past the asset name separator is the object name
+        OutOuterObjectPath = ObjectPath.Left(ObjectNameSeparatorIndex);
+        OutObjectName = ObjectPath.RightChop(ObjectNameSeparatorIndex + 1);
+    }
+    else
+    {
+        // This is a top level object (UPackage) name
+        OutOuterObjectPath = FStringView();
+        OutObjectName = ObjectPath;
+    }
+}
+
+const TSuzieFlagNameTable<EPropertyFlags>& FSuziePluginModule::GetPropertyFlagNameTable()
+{
+    // Note that only flags that are set manually (e.g. non-computed flags) should be listed here
+    static const TSuzieFlagNameTable<EPropertyFlags> PropertyFlagNameTable = {
+        {TEXT("CPF_Edit"), CPF_Edit},
+        {TEXT("CPF_ConstParm"), CPF_ConstParm},
+        {TEXT("CPF_BlueprintVisible"), CPF_BlueprintVisible},
+        {TEXT("CPF_ExportObject"), CPF_ExportObject},
+        {TEXT("CPF_BlueprintReadOnly"), CPF_BlueprintReadOnly},
+        {TEXT("CPF_Net"), CPF_Net},
+        {TEXT("CPF_EditFixedSize"), CPF_EditFixedSize},
+        {TEXT("CPF_Parm"), CPF_Parm},
+        {TEXT("CPF_OutParm"), CPF_OutParm},
+        {TEXT("CPF_ReturnParm"), CPF_ReturnParm},
+        {TEXT("CPF_DisableEditOnTemplate"), CPF_DisableEditOnTemplate},
+        {TEXT("CPF_NonNullable"), CPF_NonNullable},
+        {TEXT("CPF_Transient"), CPF_Transient},
+        {TEXT("CPF_DisableEditOnInstance"), CPF_DisableEditOnInstance},
+        {TEXT("CPF_EditConst"), CPF_EditConst},
+        {TEXT("CPF_DisableEditOnInstance"), CPF_DisableEditOnInstance},
+        {TEXT("CPF_InstancedReference"), CPF_InstancedReference},
+        {TEXT("CPF_DuplicateTransient"), CPF_DuplicateTransient},
+        {TEXT("CPF_SaveGame"), CPF_SaveGame},
+        {TEXT("CPF_NoClear"), CPF_NoClear},
+        {TEXT("CPF_SaveGame"), CPF_SaveGame},
+        {TEXT("CPF_ReferenceParm"), CPF_ReferenceParm},
+        {TEXT("CPF_BlueprintAssignable"), CPF_BlueprintAssignable},
+        {TEXT("CPF_Deprecated"), CPF_Deprecated},
+        {TEXT("CPF_RepSkip"), CPF_RepSkip},
+        {TEXT("CPF_Deprecated"), CPF_Deprecated},
+        {TEXT("CPF_RepNotify"), CPF_RepNotify},
+        {TEXT("CPF_Interp"), CPF_Interp},
+        {TEXT("CPF_NonTransactional"), CPF_NonTransactional},
+        {TEXT("CPF_EditorOnly"), CPF_EditorOnly},
+        {TEXT("CPF_AutoWeak"), CPF_AutoWeak},
+        // CPF_ContainsInstancedReference is actually computed, but it is set by the compiler and not in runtime,
+        // so we need to either carry it over (like we do here), or manually set it on container properties when their
+        // elements have CPF_ContainsInstancedReference
+        {TEXT("CPF_ContainsInstancedReference"), CPF_ContainsInstancedReference},
+        {TEXT("CPF_AssetRegistrySearchable"), CPF_AssetRegistrySearchable},
+        {TEXT("CPF_SimpleDisplay"), CPF_SimpleDisplay},
+        {TEXT("CPF_AdvancedDisplay"), CPF_AdvancedDisplay},
+        {TEXT("CPF_Protected"), CPF_Protected},
+        {TEXT("CPF_BlueprintCallable"), CPF_BlueprintCallable},
+        {TEXT("CPF_BlueprintAuthorityOnly"), CPF_BlueprintAuthorityOnly},
+        {TEXT("CPF_TextExportTransient"), CPF_TextExportTransient},
+        {TEXT("CPF_NonPIEDuplicateTransient"), CPF_NonPIEDuplicateTransient},
+        {TEXT("CPF_PersistentInstance"), CPF_PersistentInstance},
+        {TEXT("CPF_UObjectWrapper"), CPF_UObjectWrapper},
+        {TEXT("CPF_NativeAccessSpecifierPublic"), CPF_NativeAccessSpecifierPublic},
+        {TEXT("CPF_NativeAccessSpecifierProtected"), CPF_NativeAccessSpecifierProtected},
+        {TEXT("CPF_NativeAccessSpecifierPrivate"), CPF_NativeAccessSpecifierPrivate},
+        {TEXT("CPF_SkipSerialization"), CPF_SkipSerialization},
+#if (ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5)
+        // Added in 5.5, allows references to the current object from within the property
+        {TEXT("CPF_AllowSelfReference"), CPF_AllowSelfReference},
+#endif
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
+        {TEXT("CPF_RequiredParm"), CPF_RequiredParm},
+        {TEXT("CPF_TObjectPtr"), CPF_TObjectPtr},
+#endif
+        // This is set automatically for most property types, but Kismet Compiler also tags properties with this manually so carry over the flag just in case
+        {TEXT("CPF_HasGetValueTypeHash"), CPF_HasGetValueTypeHash},
+    };
+    return PropertyFlagNameTable;
+}
+
+EPropertyFlags FSuziePluginModule::ParsePropertyFlags(const FString& Flags)
+{
+    return GetPropertyFlagNameTable().Parse(Flags);
+}
+
+EClassFlags FSuziePluginModule::ParseClassFlags(const FString& Flags)
+{
+    // Note that only flags that are set manually (e.g. non-computed flags) should be listed here
+    static const TSuzieFlagNameTable<EClassFlags> ClassFlagNameTable = {
+        {TEXT("CLASS_Abstract"), CLASS_Abstract},
+        {TEXT("CLASS_EditInlineNew"), CLASS_EditInlineNew},
+        {TEXT("CLASS_NotPlaceable"), CLASS_NotPlaceable},
+        {TEXT("CLASS_CollapseCategories"), CLASS_CollapseCategories},
+        {TEXT("CLASS_Const"), CLASS_Const},
+        {TEXT("CLASS_DefaultToInstanced"), CLASS_DefaultToInstanced},
+        {TEXT("CLASS_Interface"), CLASS_Interface},
+    };
+    return ClassFlagNameTable.Parse(Flags);
+}
+
+EStructFlags FSuziePluginModule::ParseStructFlags(const FString& Flags)
+{
+    // Note that only flags that are set manually (e.g. non-computed flags) should be listed here
+    static const TSuzieFlagNameTable<EStructFlags> StructFlagNameTable = {
+        {TEXT("STRUCT_Atomic"), STRUCT_Atomic},
+        {TEXT("STRUCT_Immutable"), STRUCT_Immutable},
+    };
+    return StructFlagNameTable.Parse(Flags);
+}
+
+EFunctionFlags FSuziePluginModule::ParseFunctionFlags(const FString& Flags)
+{
     // Note that only flags that are set manually (e.g. non-computed flags) should be listed here
-    static const TArray<TPair<FString, EFunctionFlags>> FunctionFlagNameLookup = {
+    static const TSuzieFlagNameTable<EFunctionFlags> FunctionFlagNameTable = {
         {TEXT("FUNC_Final"), FUNC_Final},
         {TEXT("FUNC_BlueprintAuthorityOnly"), FUNC_BlueprintAuthorityOnly},
         {TEXT("FUNC_BlueprintCosmetic"), FUNC_BlueprintCosmetic},
@@ -716,128 +1836,87 @@ UFunction* FSuziePluginModule::FindOrCreateFunction(FDynamicClassGenerationConte
         {TEXT("FUNC_HasOutParms"), FUNC_HasOutParms},
         {TEXT("FUNC_HasDefaults"), FUNC_HasDefaults},
     };
+    return FunctionFlagNameTable.Parse(Flags);
+}
 
-    const TSharedPtr<FJsonObject> FunctionDefinition = Context.GlobalObjectMap->GetObjectField(FunctionPath);
-    checkf(FunctionDefinition.IsValid(), TEXT("Failed to find function object by path %s"), *FunctionPath);
-    
-    const FString ObjectType = FunctionDefinition->GetStringField(TEXT("type"));
-    checkf(ObjectType == TEXT("Function"), TEXT("FindOrCreateFunction expected Function object %s, got object of type %s"), *FunctionPath, *ObjectType);
-    
-    // Convert struct flag names to the struct flags bitmask
-    const TSet<FString> FunctionFlagNames = ParseFlags(FunctionDefinition->GetStringField(TEXT("function_flags")));
-    EFunctionFlags FunctionFlags = FUNC_None;
-    for (const auto& [FunctionFlagName, FunctionFlagBit] : FunctionFlagNameLookup)
-    {
-        if (FunctionFlagNames.Contains(FunctionFlagName))
-        {
-            FunctionFlags |= FunctionFlagBit;
-        }
-    }
-
-    // Have to temporarily mark the function as RF_ArchetypeObject to be able to create functions with UPackage as outer
-    UFunction* NewFunction = NewObject<UFunction>(FunctionOuterObject, *ObjectName, RF_Public | RF_MarkAsRootSet | RF_ArchetypeObject);
-    NewFunction->ClearFlags(RF_ArchetypeObject);
-    NewFunction->FunctionFlags |= FunctionFlags;
-
-    // Since this function is not marked as Native, we have to initialize Script bytecode for it
-    // Most basic valid kismet bytecode for a function would be EX_Return EX_Nothing EX_EndOfScript, so generate that
-    NewFunction->Script.Append({EX_Return, EX_Nothing, EX_EndOfScript});
-
-    // Create function parameter properties (and function return value property)
-    TArray<TSharedPtr<FJsonValue>> Properties = FunctionDefinition->GetArrayField(TEXT("properties"));
-    for (const TSharedPtr<FJsonValue>& PropertyDescriptor : Properties)
-    {
-        AddPropertyToStruct(Context, NewFunction, PropertyDescriptor->AsObject());
-    }
-
-    // This function will always be linked as a last element of the list, so it has no next element
-    NewFunction->Next = nullptr;
-
-    // Bind the function and calculate property layout and function locals size
-    NewFunction->Bind();
-    NewFunction->StaticLink(true);
+EObjectFlags FSuziePluginModule::ParseObjectFlags(const FString& Flags)
+{
+    // Parse object flags. Flags determine how the object should be created
+    static const TSuzieFlagNameTable<EObjectFlags> ObjectFlagNameTable = {
+        {TEXT("RF_Public"), RF_Public},
+        {TEXT("RF_Standalone"), RF_Standalone},
+        {TEXT("RF_Transient"), RF_Transient},
+        {TEXT("RF_Transactional"), RF_Transactional},
+        {TEXT("RF_ArchetypeObject"), RF_ArchetypeObject},
+        {TEXT("RF_ClassDefaultObject"), RF_ClassDefaultObject},
+        {TEXT("RF_DefaultSubObject"), RF_DefaultSubObject},
+    };
+    return ObjectFlagNameTable.Parse(Flags);
+}
 
-    // Do some tagging of the function for convenience based on parameter types and names
-    for (TFieldIterator<FProperty> PropertyIterator(NewFunction); PropertyIterator; ++PropertyIterator)
+TArray<FProperty*> FSuziePluginModule::AddPropertiesToStruct(FDynamicClassGenerationContext& Context, UStruct* Struct, const TArray<TSharedPtr<FJsonValue>>& PropertyDescriptors,
+    const EPropertyFlags ExtraPropertyFlags, const bool bAllowReordering)
+{
+    TArray<FProperty*> NewProperties;
+    NewProperties.Reserve(PropertyDescriptors.Num());
+    for (const TSharedPtr<FJsonValue>& PropertyDescriptor : PropertyDescriptors)
     {
-        const FProperty* Property = *PropertyIterator;
-        if (!Property->HasAllPropertyFlags(CPF_Parm) || Property->HasAnyPropertyFlags(CPF_ReturnParm)) continue;
-
-        // Object properties called WorldContext/WorldContextObject are automatically tagged as world context for convenience
-        if (Property->IsA<FObjectProperty>() && (Property->GetFName() == TEXT("WorldContext") || Property->GetFName() == TEXT("WorldContextObject")))
-        {
-            NewFunction->SetMetaData(FBlueprintMetadata::MD_WorldContext, *Property->GetName());
-        }
-        // Latent Info struct parameter properties should always be tagged as LatentInfo and indicate async BP functions
-        if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property); StructProperty && StructProperty->Struct == FLatentActionInfo::StaticStruct())
+        if (FProperty* NewProperty = BuildProperty(Context, Struct, PropertyDescriptor->AsObject(), ExtraPropertyFlags))
         {
-            NewFunction->SetMetaData(FBlueprintMetadata::MD_LatentInfo, *Property->GetName());
-            NewFunction->SetMetaData(FBlueprintMetadata::MD_Latent, TEXT("true"));
+            NewProperties.Add(NewProperty);
         }
     }
+    if (NewProperties.IsEmpty())
+    {
+        return NewProperties;
+    }
 
-    UE_LOG(LogSuzie, VeryVerbose, TEXT("Created function %s in outer %s"), *ObjectName, *FunctionOuterObject->GetName());
-    return NewFunction;
-}
+    // Properties with the same alignment keep their relative order, so the declaration order is still visible within each alignment group
+    if (bAllowReordering && CVarSuzieReorderPropertiesByAlignment.GetValueOnAnyThread())
+    {
+        Algo::StableSortBy(NewProperties, [](const FProperty* Property) { return Property->GetMinAlignment(); }, TGreater<>());
+    }
 
-void FSuziePluginModule::ParseObjectPath(const FString& ObjectPath, FString& OutOuterObjectPath, FString& OutObjectName)
-{
-    int32 ObjectNameSeparatorIndex;
-    if (ObjectPath.FindLastChar(':', ObjectNameSeparatorIndex))
+    // Chain the new properties together, and link the chain to the end of the existing property list of the struct
+    for (int32 PropertyIndex = 0; PropertyIndex < NewProperties.Num(); PropertyIndex++)
     {
-        // There is a sub-object separator in the path name, string past it is the object name
-        OutOuterObjectPath = ObjectPath.Mid(0, ObjectNameSeparatorIndex);
-        OutObjectName = ObjectPath.Mid(ObjectNameSeparatorIndex + 1);
+        NewProperties[PropertyIndex]->Next = PropertyIndex + 1 < NewProperties.Num() ? NewProperties[PropertyIndex + 1] : nullptr;
+        UE_LOG(LogSuzie, VeryVerbose, TEXT("Added property %s to struct %s"), *NewProperties[PropertyIndex]->GetName(), *Struct->GetName());
     }
-    else if (ObjectPath.FindLastChar('.', ObjectNameSeparatorIndex))
+    if (Struct->ChildProperties != nullptr)
     {
-        // This is a top level object (or this is a legacy path), string past the asset name separator is the object name
-        OutOuterObjectPath = ObjectPath.Mid(0, ObjectNameSeparatorIndex);
-        OutObjectName = ObjectPath.Mid(ObjectNameSeparatorIndex + 1);
+        FField* LastProperty = Struct->ChildProperties;
+        while (LastProperty->Next)
+        {
+            LastProperty = LastProperty->Next;
+        }
+        LastProperty->Next = NewProperties[0];
     }
     else
     {
-        // This is a top level object (UPackage) name
-        OutOuterObjectPath = TEXT("");
-        OutObjectName = ObjectPath;
+        Struct->ChildProperties = NewProperties[0];
     }
+    SUZIE_INCREMENT_COUNTER(Properties, NewProperties.Num());
+    return NewProperties;
 }
 
-TSet<FString> FSuziePluginModule::ParseFlags(const FString& Flags)
+void FSuziePluginModule::LayoutNativeClassProperties(UClass* Class, const TConstArrayView<FProperty*> Properties)
 {
-    TArray<FString> FlagsArray;
-    Flags.ParseIntoArray(FlagsArray, TEXT(" | "), true);
-    TSet<FString> ReturnFlags;
-    for (auto Flag : FlagsArray) ReturnFlags.Add(Flag);
-    return ReturnFlags;
-}
+    SUZIE_SCOPED_PHASE(StaticLink);
 
-FProperty* FSuziePluginModule::AddPropertyToStruct(FDynamicClassGenerationContext& Context, UStruct* Struct, const TSharedPtr<FJsonObject>& PropertyJson, const EPropertyFlags ExtraPropertyFlags)
-{
-    if (FProperty* NewProperty = BuildProperty(Context, Struct, PropertyJson, ExtraPropertyFlags))
+    // Linking a property places it at the current end of its owner, so the size of the class has to be kept up to date while the offsets are assigned
+    FArchive EmptyPropertyLinkArchive;
+    int32 MinAlignment = Class->MinAlignment;
+    for (FProperty* Property : Properties)
     {
-        // This property will always be linked as a last element of the list, so it has no next element
-        NewProperty->Next = nullptr;
-
-        // Link new property to the end of the linked property list
-        if (Struct->ChildProperties != nullptr)
-        {
-            FField* CurrentProperty = Struct->ChildProperties;
-            while (CurrentProperty->Next)
-            {
-                CurrentProperty = CurrentProperty->Next;
-            }
-            CurrentProperty->Next = NewProperty;
-        }
-        else
-        {
-            // This is the first property in the struct, assign it as a head of the linked property list
-            Struct->ChildProperties = NewProperty;
-        }
-        UE_LOG(LogSuzie, VeryVerbose, TEXT("Added property %s to struct %s"), *NewProperty->GetName(), *Struct->GetName());
-        return NewProperty;
+        Class->PropertiesSize = Property->Link(EmptyPropertyLinkArchive);
+        MinAlignment = FMath::Max(MinAlignment, Property->GetMinAlignment());
     }
-    return nullptr;
+    Class->MinAlignment = MinAlignment;
+#if (ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5)
+    // Added in 5.5, needs to account for every new property added to the class
+    Class->TotalFieldCount += Properties.Num();
+#endif
 }
 
 void FSuziePluginModule::AddFunctionToClass(FDynamicClassGenerationContext& Context, UClass* Class, const FString& FunctionPath, const EFunctionFlags ExtraFunctionFlags)
@@ -875,84 +1954,15 @@ void FSuziePluginModule::AddFunctionToClass(FDynamicClassGenerationContext& Cont
 
 FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Context, FFieldVariant Owner, const TSharedPtr<FJsonObject>& PropertyJson, EPropertyFlags ExtraPropertyFlags)
 {
-    // Note that only flags that are set manually (e.g. non-computed flags) should be listed here
-    static const TArray<TPair<FString, EPropertyFlags>> PropertyFlagNameLookup = {
-        {TEXT("CPF_Edit"), CPF_Edit},
-        {TEXT("CPF_ConstParm"), CPF_ConstParm},
-        {TEXT("CPF_BlueprintVisible"), CPF_BlueprintVisible},
-        {TEXT("CPF_ExportObject"), CPF_ExportObject},
-        {TEXT("CPF_BlueprintReadOnly"), CPF_BlueprintReadOnly},
-        {TEXT("CPF_Net"), CPF_Net},
-        {TEXT("CPF_EditFixedSize"), CPF_EditFixedSize},
-        {TEXT("CPF_Parm"), CPF_Parm},
-        {TEXT("CPF_OutParm"), CPF_OutParm},
-        {TEXT("CPF_ReturnParm"), CPF_ReturnParm},
-        {TEXT("CPF_DisableEditOnTemplate"), CPF_DisableEditOnTemplate},
-        {TEXT("CPF_NonNullable"), CPF_NonNullable},
-        {TEXT("CPF_Transient"), CPF_Transient},
-        {TEXT("CPF_DisableEditOnInstance"), CPF_DisableEditOnInstance},
-        {TEXT("CPF_EditConst"), CPF_EditConst},
-        {TEXT("CPF_DisableEditOnInstance"), CPF_DisableEditOnInstance},
-        {TEXT("CPF_InstancedReference"), CPF_InstancedReference},
-        {TEXT("CPF_DuplicateTransient"), CPF_DuplicateTransient},
-        {TEXT("CPF_SaveGame"), CPF_SaveGame},
-        {TEXT("CPF_NoClear"), CPF_NoClear},
-        {TEXT("CPF_SaveGame"), CPF_SaveGame},
-        {TEXT("CPF_ReferenceParm"), CPF_ReferenceParm},
-        {TEXT("CPF_BlueprintAssignable"), CPF_BlueprintAssignable},
-        {TEXT("CPF_Deprecated"), CPF_Deprecated},
-        {TEXT("CPF_RepSkip"), CPF_RepSkip},
-        {TEXT("CPF_Deprecated"), CPF_Deprecated},
-        {TEXT("CPF_RepNotify"), CPF_RepNotify},
-        {TEXT("CPF_Interp"), CPF_Interp},
-        {TEXT("CPF_NonTransactional"), CPF_NonTransactional},
-        {TEXT("CPF_EditorOnly"), CPF_EditorOnly},
-        {TEXT("CPF_AutoWeak"), CPF_AutoWeak},
-        // CPF_ContainsInstancedReference is actually computed, but it is set by the compiler and not in runtime,
-        // so we need to either carry it over (like we do here), or manually set it on container properties when their
-        // elements have CPF_ContainsInstancedReference
-        {TEXT("CPF_ContainsInstancedReference"), CPF_ContainsInstancedReference},
-        {TEXT("CPF_AssetRegistrySearchable"), CPF_AssetRegistrySearchable},
-        {TEXT("CPF_SimpleDisplay"), CPF_SimpleDisplay},
-        {TEXT("CPF_AdvancedDisplay"), CPF_AdvancedDisplay},
-        {TEXT("CPF_Protected"), CPF_Protected},
-        {TEXT("CPF_BlueprintCallable"), CPF_BlueprintCallable},
-        {TEXT("CPF_BlueprintAuthorityOnly"), CPF_BlueprintAuthorityOnly},
-        {TEXT("CPF_TextExportTransient"), CPF_TextExportTransient},
-        {TEXT("CPF_NonPIEDuplicateTransient"), CPF_NonPIEDuplicateTransient},
-        {TEXT("CPF_PersistentInstance"), CPF_PersistentInstance},
-        {TEXT("CPF_UObjectWrapper"), CPF_UObjectWrapper},
-        {TEXT("CPF_NativeAccessSpecifierPublic"), CPF_NativeAccessSpecifierPublic},
-        {TEXT("CPF_NativeAccessSpecifierProtected"), CPF_NativeAccessSpecifierProtected},
-        {TEXT("CPF_NativeAccessSpecifierPrivate"), CPF_NativeAccessSpecifierPrivate},
-        {TEXT("CPF_SkipSerialization"), CPF_SkipSerialization},
-#if (ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5)
-        // Added in 5.5, allows references to the current object from within the property
-        {TEXT("CPF_AllowSelfReference"), CPF_AllowSelfReference},
-#endif
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 6
-        {TEXT("CPF_RequiredParm"), CPF_RequiredParm},
-        {TEXT("CPF_TObjectPtr"), CPF_TObjectPtr},
-#endif
-        // This is set automatically for most property types, but Kismet Compiler also tags properties with this manually so carry over the flag just in case
-        {TEXT("CPF_HasGetValueTypeHash"), CPF_HasGetValueTypeHash},
-    };
+    SUZIE_SCOPED_PHASE(PropertyCreation);
 
-    // Convert struct flag names to the struct flags bitmask
-    const TSet<FString> PropertyFlagNames = ParseFlags(PropertyJson->GetStringField(TEXT("flags")));
-    EPropertyFlags PropertyFlags = ExtraPropertyFlags;
-    for (const auto& [PropertyFlagName, PropertyFlagBit] : PropertyFlagNameLookup)
-    {
-        if (PropertyFlagNames.Contains(PropertyFlagName))
-        {
-            PropertyFlags |= PropertyFlagBit;
-        }
-    }
+    // Convert property flag names to the property flags bitmask
+    const EPropertyFlags PropertyFlags = ExtraPropertyFlags | ParsePropertyFlags(PropertyJson->GetStringField(TEXT("flags")));
 
     const FString PropertyName = PropertyJson->GetStringField(TEXT("name"));
     const FString PropertyType = PropertyJson->GetStringField(TEXT("type"));
 
-    FProperty* NewProperty = CastField<FProperty>(FField::Construct(FName(*PropertyType), Owner, FName(*PropertyName), RF_Public));
+    FProperty* NewProperty = CastField<FProperty>(FField::Construct(Context.NameTable->FindOrAdd(PropertyType), Owner, Context.NameTable->FindOrAdd(PropertyName), RF_Public));
     if (NewProperty == nullptr)
     {
         UE_LOG(LogSuzie, Warning, TEXT("Failed to create property of type %s: not supported"), *PropertyType);
@@ -1067,47 +2077,24 @@ FProperty* FSuziePluginModule::BuildProperty(FDynamicClassGenerationContext& Con
     return NewProperty;
 }
 
-bool FSuziePluginModule::ParseObjectConstructionData(const FDynamicClassGenerationContext& Context, const FString& ObjectPath, FDynamicObjectConstructionData& ObjectConstructionData)
+bool FSuziePluginModule::ParseObjectConstructionData(const FDynamicClassGenerationContext& Context, const FDynamicObjectRecord& ObjectRecord, FDynamicObjectConstructionData& ObjectConstructionData)
 {
-    // Retrieve the data for the object
-    const TSharedPtr<FJsonObject> ObjectDefinition = Context.GlobalObjectMap->GetObjectField(ObjectPath);
-    checkf(ObjectDefinition.IsValid(), TEXT("Failed to find data object by path %s"), *ObjectPath);
-
-    FString OuterObjectPath;
-    FString ObjectName;
-    ParseObjectPath(ObjectPath, OuterObjectPath, ObjectName);
-    ObjectConstructionData.ObjectName = FName(*ObjectName);
-
     // Find the class of this object
-    const FString ObjectClassPath = ObjectDefinition->GetStringField(TEXT("class"));
-    ObjectConstructionData.ObjectClass = FindObject<UClass>(nullptr, *ObjectClassPath);
+    return ParseObjectConstructionData(ObjectRecord, FindObject<UClass>(nullptr, *ObjectRecord.ClassPath.ToString()), ObjectConstructionData);
+}
+
+bool FSuziePluginModule::ParseObjectConstructionData(const FDynamicObjectRecord& ObjectRecord, UClass* ObjectClass, FDynamicObjectConstructionData& ObjectConstructionData)
+{
+    ObjectConstructionData.ObjectName = ObjectRecord.ObjectName;
+    ObjectConstructionData.ObjectClass = ObjectClass;
     if (ObjectConstructionData.ObjectClass == nullptr)
     {
-        UE_LOG(LogSuzie, Warning, TEXT("Failed to parse data object %s because its class %s was not found"), *ObjectPath, *ObjectClassPath);
+        UE_LOG(LogSuzie, Warning, TEXT("Failed to parse data object %s because its class %s was not found"), *ObjectRecord.ObjectPath.ToString(), *ObjectRecord.ClassPath.ToString());
         return false;
     }
 
-    // Parse object flags. Flags determine how the object should be created
-    static const TArray<TPair<FString, EObjectFlags>> ObjectFlagNameLookup = {
-        {TEXT("RF_Public"), RF_Public},
-        {TEXT("RF_Standalone"), RF_Standalone},
-        {TEXT("RF_Transient"), RF_Transient},
-        {TEXT("RF_Transactional"), RF_Transactional},
-        {TEXT("RF_ArchetypeObject"), RF_ArchetypeObject},
-        {TEXT("RF_ClassDefaultObject"), RF_ClassDefaultObject},
-        {TEXT("RF_DefaultSubObject"), RF_DefaultSubObject},
-    };
-
-    // Convert struct flag names to the struct flags bitmask
-    const TSet<FString> ObjectFlagNames = ParseFlags(ObjectDefinition->GetStringField(TEXT("object_flags")));
-    ObjectConstructionData.ObjectFlags = RF_NoFlags;
-    for (const auto& [ObjectFlagName, ObjectFlagBitmask] : ObjectFlagNameLookup)
-    {
-        if (ObjectFlagNames.Contains(ObjectFlagName))
-        {
-            ObjectConstructionData.ObjectFlags |= ObjectFlagBitmask;
-        }
-    }
+    // Flags determine how the object should be created
+    ObjectConstructionData.ObjectFlags = ObjectRecord.ObjectFlags;
     return true;
 }
 
@@ -1146,171 +2133,424 @@ void FSuziePluginModule::DeserializeEnumValue(const FNumericProperty* Underlying
     }
 }
 
-void FSuziePluginModule::DeserializePropertyValue(const FProperty* Property, void* PropertyValuePtr, const TSharedPtr<FJsonValue>& JsonPropertyValue)
+EDynamicPropertyValueHandler FSuziePluginModule::GetPropertyValueHandler(const FProperty* Property)
 {
-    if (const FSoftObjectProperty* SoftObjectProperty = CastField<FSoftObjectProperty>(Property))
+    // Note that the order matters here, soft object properties are object properties too, and numeric properties can be enum-backed byte properties
+    if (Property->IsA<FSoftObjectProperty>())
     {
-        // We do not actually have to load or look for object pointed by soft object properties, we can just set the value as object path instead
-        const FSoftObjectPtr SoftObjectPtr(FSoftObjectPath(JsonPropertyValue->AsString()));
-        SoftObjectProperty->SetPropertyValue(PropertyValuePtr, SoftObjectPtr);
+        return EDynamicPropertyValueHandler::SoftObject;
     }
-    else if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+    if (Property->IsA<FObjectPropertyBase>())
     {
-        if (!JsonPropertyValue->IsNull())
-        {
-            // For all other object properties, we must already have the object pointed at in memory, we will not load any objects here
-            UObject* Object = StaticFindObject(ObjectProperty->PropertyClass, nullptr, *JsonPropertyValue->AsString());
-            ObjectProperty->SetObjectPropertyValue(PropertyValuePtr, Object);
-        }
+        return EDynamicPropertyValueHandler::Object;
     }
-    else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+    if (Property->IsA<FBoolProperty>())
     {
-        // Bool properties need special handling because they are represented as JSON booleans
-        BoolProperty->SetPropertyValue(PropertyValuePtr, JsonPropertyValue->AsBool());
+        return EDynamicPropertyValueHandler::Bool;
     }
-    else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property); NumericProperty && !NumericProperty->IsEnum())
+    if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property); NumericProperty && !NumericProperty->IsEnum())
     {
-        if (JsonPropertyValue->Type == EJson::Number)
-        {
-            // If this is a floating point property, just set it to the JSON value
-            if (NumericProperty->IsFloatingPoint())
-            {
-                NumericProperty->SetFloatingPointPropertyValue(PropertyValuePtr, JsonPropertyValue->AsNumber());
-            }
-            else
-            {
-                // This is an integer property otherwise. Whenever its signed or unsigned does not matter here,
-                // because for really large values they will be saved as text and not double
-                NumericProperty->SetIntPropertyValue(PropertyValuePtr, (int64)JsonPropertyValue->AsNumber());
-            }
-        }
-        else
-        {
-            // This is a string representation of the number, let the numeric property parse it
-            NumericProperty->SetNumericPropertyValueFromString(PropertyValuePtr, *JsonPropertyValue->AsString());
-        }
+        return EDynamicPropertyValueHandler::Numeric;
     }
-    else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+    if (Property->IsA<FNameProperty>())
     {
-        NameProperty->SetPropertyValue(PropertyValuePtr, FName(*JsonPropertyValue->AsString()));
+        return EDynamicPropertyValueHandler::Name;
     }
-    else if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+    if (Property->IsA<FStrProperty>())
     {
-        StrProperty->SetPropertyValue(PropertyValuePtr, JsonPropertyValue->AsString());
+        return EDynamicPropertyValueHandler::Str;
     }
-    else if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+    if (Property->IsA<FTextProperty>())
     {
-        // TODO: Implement once dump format is known
-        TextProperty->SetPropertyValue(PropertyValuePtr, FText::AsCultureInvariant(JsonPropertyValue->AsString()));
+        return EDynamicPropertyValueHandler::Text;
     }
-    else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property); EnumProperty && EnumProperty->GetEnum())
+    if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property); EnumProperty && EnumProperty->GetEnum())
     {
-        DeserializeEnumValue(EnumProperty->GetUnderlyingProperty(), PropertyValuePtr, EnumProperty->GetEnum(), JsonPropertyValue);
+        return EDynamicPropertyValueHandler::Enum;
     }
-    else if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property); ByteProperty && ByteProperty->Enum)
+    if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property); ByteProperty && ByteProperty->Enum)
     {
         // Non enum byte properties are handled above as FNumericProperty case
-        DeserializeEnumValue(ByteProperty, PropertyValuePtr, ByteProperty->Enum, JsonPropertyValue);
+        return EDynamicPropertyValueHandler::ByteEnum;
     }
-    else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property); StructProperty && StructProperty->Struct)
+    if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property); StructProperty && StructProperty->Struct)
     {
-        // Deserialize nested struct properties payload
-        DeserializeStructProperties(StructProperty->Struct, PropertyValuePtr, JsonPropertyValue->AsObject());
+        return EDynamicPropertyValueHandler::Struct;
     }
-    else if (const FFieldPathProperty* FieldPathProperty = CastField<FFieldPathProperty>(Property))
+    if (Property->IsA<FFieldPathProperty>())
     {
-        const TFieldPath<FProperty> FieldPath(*JsonPropertyValue->AsString());
-        FieldPathProperty->SetPropertyValue(PropertyValuePtr, FieldPath);
+        return EDynamicPropertyValueHandler::FieldPath;
     }
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
-    else if (const FOptionalProperty* OptionalProperty = CastField<FOptionalProperty>(Property))
+    if (Property->IsA<FOptionalProperty>())
+    {
+        return EDynamicPropertyValueHandler::Optional;
+    }
+#endif
+    if (Property->IsA<FArrayProperty>())
+    {
+        return EDynamicPropertyValueHandler::Array;
+    }
+    if (Property->IsA<FSetProperty>())
+    {
+        return EDynamicPropertyValueHandler::Set;
+    }
+    if (Property->IsA<FMapProperty>())
+    {
+        return EDynamicPropertyValueHandler::Map;
+    }
+    return EDynamicPropertyValueHandler::Unsupported;
+}
+
+// Writes the JSON values straight into the elements of a numeric array, rather than through the virtual setters of the element property
+template<typename ElementType>
+static void DeserializeNumericArrayElements(const FNumericProperty* ElementProperty, void* ElementData, const TArray<TSharedPtr<FJsonValue>>& ElementJsonValues)
+{
+    ElementType* Elements = static_cast<ElementType*>(ElementData);
+    for (int32 ElementIndex = 0; ElementIndex < ElementJsonValues.Num(); ElementIndex++)
     {
-        // If JSON property value is null, optional property is unset
-        if (JsonPropertyValue->Type == EJson::Null)
+        const FJsonValue& ElementJsonValue = *ElementJsonValues[ElementIndex];
+        if (ElementJsonValue.Type != EJson::Number)
+        {
+            // Large integers are dumped as strings, let the property parse them
+            ElementProperty->SetNumericPropertyValueFromString(&Elements[ElementIndex], *ElementJsonValue.AsString());
+        }
+        else if constexpr (std::is_floating_point_v<ElementType>)
         {
-            OptionalProperty->MarkUnset(PropertyValuePtr);
+            Elements[ElementIndex] = (ElementType)ElementJsonValue.AsNumber();
         }
         else
         {
-            // Deserialize the inner property value otherwise
-            void* ValuePropertyValuePtr = OptionalProperty->MarkSetAndGetInitializedValuePointerToReplace(PropertyValuePtr);
-            DeserializePropertyValue(OptionalProperty->GetValueProperty(), ValuePropertyValuePtr, JsonPropertyValue);
+            // Same conversion as SetIntPropertyValue, unsigned values are converted from the signed value
+            Elements[ElementIndex] = (ElementType)(int64)ElementJsonValue.AsNumber();
         }
     }
-#endif
-    else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+}
+
+// Decodes all elements of an array of numbers or booleans at once. Returns false for other element types, which have to be decoded element by element
+static bool TryDeserializePlainArrayElements(const FProperty* ElementProperty, void* ElementData, const TArray<TSharedPtr<FJsonValue>>& ElementJsonValues)
+{
+    if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(ElementProperty))
+    {
+        // Array elements are always native booleans, but the elements are written as whole bytes so make sure of it
+        if (!BoolProperty->IsNativeBool())
+        {
+            return false;
+        }
+        bool* Elements = static_cast<bool*>(ElementData);
+        for (int32 ElementIndex = 0; ElementIndex < ElementJsonValues.Num(); ElementIndex++)
+        {
+            Elements[ElementIndex] = ElementJsonValues[ElementIndex]->AsBool();
+        }
+        return true;
+    }
+    const FNumericProperty* NumericProperty = CastField<FNumericProperty>(ElementProperty);
+    if (NumericProperty == nullptr)
+    {
+        return false;
+    }
+    if (NumericProperty->IsA<FFloatProperty>()) { DeserializeNumericArrayElements<float>(NumericProperty, ElementData, ElementJsonValues); }
+    else if (NumericProperty->IsA<FDoubleProperty>()) { DeserializeNumericArrayElements<double>(NumericProperty, ElementData, ElementJsonValues); }
+    else if (NumericProperty->IsA<FInt8Property>()) { DeserializeNumericArrayElements<int8>(NumericProperty, ElementData, ElementJsonValues); }
+    else if (NumericProperty->IsA<FByteProperty>()) { DeserializeNumericArrayElements<uint8>(NumericProperty, ElementData, ElementJsonValues); }
+    else if (NumericProperty->IsA<FInt16Property>()) { DeserializeNumericArrayElements<int16>(NumericProperty, ElementData, ElementJsonValues); }
+    else if (NumericProperty->IsA<FUInt16Property>()) { DeserializeNumericArrayElements<uint16>(NumericProperty, ElementData, ElementJsonValues); }
+    else if (NumericProperty->IsA<FIntProperty>()) { DeserializeNumericArrayElements<int32>(NumericProperty, ElementData, ElementJsonValues); }
+    else if (NumericProperty->IsA<FUInt32Property>()) { DeserializeNumericArrayElements<uint32>(NumericProperty, ElementData, ElementJsonValues); }
+    else if (NumericProperty->IsA<FInt64Property>()) { DeserializeNumericArrayElements<int64>(NumericProperty, ElementData, ElementJsonValues); }
+    else if (NumericProperty->IsA<FUInt64Property>()) { DeserializeNumericArrayElements<uint64>(NumericProperty, ElementData, ElementJsonValues); }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void FSuziePluginModule::DeserializePropertyValue(const FProperty* Property, void* PropertyValuePtr, const TSharedPtr<FJsonValue>& JsonPropertyValue)
+{
+    DeserializePropertyValueWithHandler(GetPropertyValueHandler(Property), Property, PropertyValuePtr, JsonPropertyValue);
+}
+
+void FSuziePluginModule::DeserializePropertyValueWithHandler(const EDynamicPropertyValueHandler Handler, const FProperty* Property, void* PropertyValuePtr, const TSharedPtr<FJsonValue>& JsonPropertyValue)
+{
+    switch (Handler)
     {
-        const TArray<TSharedPtr<FJsonValue>>& ArrayElementJsonValues = JsonPropertyValue->AsArray();
-        FScriptArrayHelper ArrayValueHelper(ArrayProperty, PropertyValuePtr);
+    case EDynamicPropertyValueHandler::SoftObject:
+        {
+            // We do not actually have to load or look for object pointed by soft object properties, we can just set the value as object path instead
+            const FSoftObjectPtr SoftObjectPtr(FSoftObjectPath(JsonPropertyValue->AsString()));
+            static_cast<const FSoftObjectProperty*>(Property)->SetPropertyValue(PropertyValuePtr, SoftObjectPtr);
+            break;
+        }
+    case EDynamicPropertyValueHandler::Object:
+        {
+            if (!JsonPropertyValue->IsNull())
+            {
+                // For all other object properties, we must already have the object pointed at in memory, we will not load any objects here
+                const FObjectPropertyBase* ObjectProperty = static_cast<const FObjectPropertyBase*>(Property);
+                UObject* Object = StaticFindObject(ObjectProperty->PropertyClass, nullptr, *JsonPropertyValue->AsString());
+                ObjectProperty->SetObjectPropertyValue(PropertyValuePtr, Object);
+            }
+            break;
+        }
+    case EDynamicPropertyValueHandler::Bool:
+        {
+            // Bool properties need special handling because they are represented as JSON booleans
+            static_cast<const FBoolProperty*>(Property)->SetPropertyValue(PropertyValuePtr, JsonPropertyValue->AsBool());
+            break;
+        }
+    case EDynamicPropertyValueHandler::Numeric:
+        {
+            const FNumericProperty* NumericProperty = static_cast<const FNumericProperty*>(Property);
+            if (JsonPropertyValue->Type == EJson::Number)
+            {
+                // If this is a floating point property, just set it to the JSON value
+                if (NumericProperty->IsFloatingPoint())
+                {
+                    NumericProperty->SetFloatingPointPropertyValue(PropertyValuePtr, JsonPropertyValue->AsNumber());
+                }
+                else
+                {
+                    // This is an integer property otherwise. Whenever its signed or unsigned does not matter here,
+                    // because for really large values they will be saved as text and not double
+                    NumericProperty->SetIntPropertyValue(PropertyValuePtr, (int64)JsonPropertyValue->AsNumber());
+                }
+            }
+            else
+            {
+                // This is a string representation of the number, let the numeric property parse it
+                NumericProperty->SetNumericPropertyValueFromString(PropertyValuePtr, *JsonPropertyValue->AsString());
+            }
+            break;
+        }
+    case EDynamicPropertyValueHandler::Name:
+        {
+            static_cast<const FNameProperty*>(Property)->SetPropertyValue(PropertyValuePtr, FName(*JsonPropertyValue->AsString()));
+            break;
+        }
+    case EDynamicPropertyValueHandler::Str:
+        {
+            static_cast<const FStrProperty*>(Property)->SetPropertyValue(PropertyValuePtr, JsonPropertyValue->AsString());
+            break;
+        }
+    case EDynamicPropertyValueHandler::Text:
+        {
+            // TODO: Implement once dump format is known
+            static_cast<const FTextProperty*>(Property)->SetPropertyValue(PropertyValuePtr, FText::AsCultureInvariant(JsonPropertyValue->AsString()));
+            break;
+        }
+    case EDynamicPropertyValueHandler::Enum:
+        {
+            const FEnumProperty* EnumProperty = static_cast<const FEnumProperty*>(Property);
+            DeserializeEnumValue(EnumProperty->GetUnderlyingProperty(), PropertyValuePtr, EnumProperty->GetEnum(), JsonPropertyValue);
+            break;
+        }
+    case EDynamicPropertyValueHandler::ByteEnum:
+        {
+            const FByteProperty* ByteProperty = static_cast<const FByteProperty*>(Property);
+            DeserializeEnumValue(ByteProperty, PropertyValuePtr, ByteProperty->Enum, JsonPropertyValue);
+            break;
+        }
+    case EDynamicPropertyValueHandler::Struct:
+        {
+            // Deserialize nested struct properties payload
+            DeserializeStructProperties(static_cast<const FStructProperty*>(Property)->Struct, PropertyValuePtr, JsonPropertyValue->AsObject());
+            break;
+        }
+    case EDynamicPropertyValueHandler::FieldPath:
+        {
+            const TFieldPath<FProperty> FieldPath(*JsonPropertyValue->AsString());
+            static_cast<const FFieldPathProperty*>(Property)->SetPropertyValue(PropertyValuePtr, FieldPath);
+            break;
+        }
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+    case EDynamicPropertyValueHandler::Optional:
+        {
+            const FOptionalProperty* OptionalProperty = static_cast<const FOptionalProperty*>(Property);
+            // If JSON property value is null, optional property is unset
+            if (JsonPropertyValue->Type == EJson::Null)
+            {
+                OptionalProperty->MarkUnset(PropertyValuePtr);
+            }
+            else
+            {
+                // Deserialize the inner property value otherwise
+                void* ValuePropertyValuePtr = OptionalProperty->MarkSetAndGetInitializedValuePointerToReplace(PropertyValuePtr);
+                DeserializePropertyValue(OptionalProperty->GetValueProperty(), ValuePropertyValuePtr, JsonPropertyValue);
+            }
+            break;
+        }
+#endif
+    case EDynamicPropertyValueHandler::Array:
+        {
+            const FArrayProperty* ArrayProperty = static_cast<const FArrayProperty*>(Property);
+            const TArray<TSharedPtr<FJsonValue>>& ArrayElementJsonValues = JsonPropertyValue->AsArray();
+            FScriptArrayHelper ArrayValueHelper(ArrayProperty, PropertyValuePtr);
+
+            // All elements share the same property, so only resolve its handler once
+            const EDynamicPropertyValueHandler InnerHandler = GetPropertyValueHandler(ArrayProperty->Inner);
+            ArrayValueHelper.Resize(ArrayElementJsonValues.Num());
+
+            // Enum-backed numbers are handled by the enum handlers, so numeric elements here are always plain numbers
+            const bool bPlainElements = InnerHandler == EDynamicPropertyValueHandler::Numeric || InnerHandler == EDynamicPropertyValueHandler::Bool;
+            if (bPlainElements && ArrayElementJsonValues.Num() > 0 && CVarSuzieBulkContainerDeserialization.GetValueOnAnyThread() &&
+                TryDeserializePlainArrayElements(ArrayProperty->Inner, ArrayValueHelper.GetRawPtr(0), ArrayElementJsonValues))
+            {
+                break;
+            }
+            for (int32 ElementIndex = 0; ElementIndex < ArrayElementJsonValues.Num(); ElementIndex++)
+            {
+                // GetElementPtr does not exist in <5.3 and this one will inline
+                // If inlining is undesirable, wrapper or ifdef can be used
+                void* ElementValuePtr = ArrayValueHelper.GetRawPtr(ElementIndex);
+                DeserializePropertyValueWithHandler(InnerHandler, ArrayProperty->Inner, ElementValuePtr, ArrayElementJsonValues[ElementIndex]);
+            }
+            break;
+        }
+    case EDynamicPropertyValueHandler::Set:
+        {
+            const FSetProperty* SetProperty = static_cast<const FSetProperty*>(Property);
+            const TArray<TSharedPtr<FJsonValue>>& SetElementJsonValues = JsonPropertyValue->AsArray();
+            FScriptSetHelper SetValueHelper(SetProperty, PropertyValuePtr);
 
-        ArrayValueHelper.Resize(ArrayElementJsonValues.Num());
-        for (int32 ElementIndex = 0; ElementIndex < ArrayElementJsonValues.Num(); ElementIndex++)
+            const EDynamicPropertyValueHandler ElementHandler = GetPropertyValueHandler(SetProperty->ElementProp);
+            // Values are merged into the existing set, so only an empty set can be reserved without losing its elements
+            if (SetValueHelper.Num() == 0 && CVarSuzieBulkContainerDeserialization.GetValueOnAnyThread())
+            {
+                SetValueHelper.EmptyElements(SetElementJsonValues.Num());
+            }
+            for (const TSharedPtr<FJsonValue>& ElementJsonValue : SetElementJsonValues)
+            {
+                const int32 NewElementIndex = SetValueHelper.AddDefaultValue_Invalid_NeedsRehash();
+                void* ElementValuePtr = SetValueHelper.GetElementPtr(NewElementIndex);
+                DeserializePropertyValueWithHandler(ElementHandler, SetProperty->ElementProp, ElementValuePtr, ElementJsonValue);
+            }
+            SetValueHelper.Rehash();
+            break;
+        }
+    case EDynamicPropertyValueHandler::Map:
         {
-            // GetElementPtr does not exist in <5.3 and this one will inline
-            // If inlining is undesirable, wrapper or ifdef can be used
-            void* ElementValuePtr = ArrayValueHelper.GetRawPtr(ElementIndex);
-            DeserializePropertyValue(ArrayProperty->Inner, ElementValuePtr, ArrayElementJsonValues[ElementIndex]);
+            const FMapProperty* MapProperty = static_cast<const FMapProperty*>(Property);
+            const TArray<TSharedPtr<FJsonValue>>& MapPairJsonValues = JsonPropertyValue->AsArray();
+            FScriptMapHelper MapValueHelper(MapProperty, PropertyValuePtr);
+
+            const EDynamicPropertyValueHandler KeyHandler = GetPropertyValueHandler(MapProperty->KeyProp);
+            const EDynamicPropertyValueHandler ValueHandler = GetPropertyValueHandler(MapProperty->ValueProp);
+            if (MapValueHelper.Num() == 0 && CVarSuzieBulkContainerDeserialization.GetValueOnAnyThread())
+            {
+                MapValueHelper.EmptyValues(MapPairJsonValues.Num());
+            }
+            for (const TSharedPtr<FJsonValue>& ElementJsonValue : MapPairJsonValues)
+            {
+                const int32 NewPairIndex = MapValueHelper.AddDefaultValue_Invalid_NeedsRehash();
+                void* KeyElementPtr = MapValueHelper.GetKeyPtr(NewPairIndex);
+                void* ValueElementPtr = MapValueHelper.GetValuePtr(NewPairIndex);
+
+                const TArray<TSharedPtr<FJsonValue>>& PairValue = ElementJsonValue->AsArray();
+                if (PairValue.Num() == 2)
+                {
+                    DeserializePropertyValueWithHandler(KeyHandler, MapProperty->KeyProp, KeyElementPtr, PairValue[0]);
+                    DeserializePropertyValueWithHandler(ValueHandler, MapProperty->ValueProp, ValueElementPtr, PairValue[1]);
+                }
+            }
+            MapValueHelper.Rehash();
+            break;
         }
+    case EDynamicPropertyValueHandler::Unsupported:
+    default:
+        break;
     }
-    else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+}
+
+const FDynamicStructDeserializationPlan& FSuziePluginModule::FindOrCreateStructDeserializationPlan(const UStruct* Struct)
+{
+    if (const TUniquePtr<FDynamicStructDeserializationPlan>* ExistingPlan = StructDeserializationPlans.Find(Struct))
     {
-        const TArray<TSharedPtr<FJsonValue>>& SetElementJsonValues = JsonPropertyValue->AsArray();
-        FScriptSetHelper SetValueHelper(SetProperty, PropertyValuePtr);
-        
-        for (const TSharedPtr<FJsonValue>& ElementJsonValue : SetElementJsonValues)
+        return **ExistingPlan;
+    }
+
+    // Plans are read from worker threads while classes are being finalized, so they can only be added on the game thread
+    checkf(IsInGameThread(), TEXT("Deserialization plan for %s has to be created on the game thread"), *Struct->GetPathName());
+
+    // Structs are only deserialized into once they have been linked, so their property layout will not change after this point
+    TUniquePtr<FDynamicStructDeserializationPlan> NewPlan = MakeUnique<FDynamicStructDeserializationPlan>();
+    for (TFieldIterator<FProperty> PropertyIterator(Struct, EFieldIterationFlags::IncludeAll); PropertyIterator; ++PropertyIterator)
+    {
+        const FProperty* Property = *PropertyIterator;
+        const EDynamicPropertyValueHandler Handler = GetPropertyValueHandler(Property);
+        if (Handler == EDynamicPropertyValueHandler::Unsupported)
+        {
+            continue;
+        }
+
+        // Properties of the struct itself are iterated before the properties of its parents, so they take precedence if the names clash
+        const FString PropertyName = Property->GetName();
+        if (!NewPlan->PropertiesByName.Contains(PropertyName))
         {
-            const int32 NewElementIndex = SetValueHelper.AddDefaultValue_Invalid_NeedsRehash();
-            void* ElementValuePtr = SetValueHelper.GetElementPtr(NewElementIndex);
-            DeserializePropertyValue(SetProperty->ElementProp, ElementValuePtr, ElementJsonValue);
+            NewPlan->PropertiesByName.Add(PropertyName, {Property, Property->GetOffset_ForInternal(), Property->GetElementSize(), Property->ArrayDim, Handler,
+                CanDecodePropertyValueOffGameThread(Handler, Property)});
         }
-        SetValueHelper.Rehash();
     }
-    else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
-    {
-        const TArray<TSharedPtr<FJsonValue>>& MapPairJsonValues = JsonPropertyValue->AsArray();
-        FScriptMapHelper MapValueHelper(MapProperty, PropertyValuePtr);
-        
-        for (const TSharedPtr<FJsonValue>& ElementJsonValue : MapPairJsonValues)
-        {
-            const int32 NewPairIndex = MapValueHelper.AddDefaultValue_Invalid_NeedsRehash();
-            void* KeyElementPtr = MapValueHelper.GetKeyPtr(NewPairIndex);
-            void* ValueElementPtr = MapValueHelper.GetValuePtr(NewPairIndex);
+    return *StructDeserializationPlans.Add(Struct, MoveTemp(NewPlan));
+}
 
-            const TArray<TSharedPtr<FJsonValue>>& PairValue = ElementJsonValue->AsArray();
-            if (PairValue.Num() == 2)
-            {
-                DeserializePropertyValue(MapProperty->KeyProp, KeyElementPtr, PairValue[0]);
-                DeserializePropertyValue(MapProperty->ValueProp, ValueElementPtr, PairValue[1]);
-            }
+const FDynamicStructDeserializationPlan* FSuziePluginModule::FindStructDeserializationPlan(const UStruct* Struct) const
+{
+    const TUniquePtr<FDynamicStructDeserializationPlan>* ExistingPlan = StructDeserializationPlans.Find(Struct);
+    return ExistingPlan ? ExistingPlan->Get() : nullptr;
+}
+
+bool FSuziePluginModule::CanDecodePropertyValueOffGameThread(const EDynamicPropertyValueHandler Handler, const FProperty* Property)
+{
+    switch (Handler)
+    {
+    case EDynamicPropertyValueHandler::SoftObject:
+    case EDynamicPropertyValueHandler::Numeric:
+    case EDynamicPropertyValueHandler::Name:
+    case EDynamicPropertyValueHandler::Str:
+    case EDynamicPropertyValueHandler::Text:
+    case EDynamicPropertyValueHandler::Enum:
+    case EDynamicPropertyValueHandler::ByteEnum:
+    case EDynamicPropertyValueHandler::FieldPath:
+        return true;
+    case EDynamicPropertyValueHandler::Array:
+        {
+            // Arrays are resized to the number of elements in the dump, so the decoded array replaces the existing one entirely
+            const FProperty* InnerProperty = static_cast<const FArrayProperty*>(Property)->Inner;
+            return CanDecodePropertyValueOffGameThread(GetPropertyValueHandler(InnerProperty), InnerProperty);
         }
-        MapValueHelper.Rehash();
+    default:
+        // Object references have to be resolved, bitfield booleans cannot live in a separate buffer,
+        // and structs, sets, maps and optionals are merged into the existing value instead of replacing it
+        return false;
     }
 }
 
-void FSuziePluginModule::DeserializeStructProperties(const UStruct* Struct, void* StructData, const TSharedPtr<FJsonObject>& PropertyValues)
+void FSuziePluginModule::DeserializeStructProperties(const UStruct* Struct, void* StructData, const TSharedPtr<FJsonObject>& PropertyValues, const bool bSkipOffGameThreadProperties)
 {
-    for (TFieldIterator<FProperty> PropertyIterator(Struct, EFieldIterationFlags::IncludeAll); PropertyIterator; ++PropertyIterator)
+    const FDynamicStructDeserializationPlan& Plan = FindOrCreateStructDeserializationPlan(Struct);
+
+    // Values are usually only present for a few properties of a struct, so iterate the values rather than the properties
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& PropertyValue : PropertyValues->Values)
     {
-        const FProperty* Property = *PropertyIterator;
-        if (!PropertyValues->HasField(Property->GetName())) continue;
+        const FDynamicPropertyDeserializationPlanEntry* PlanEntry = Plan.PropertiesByName.Find(PropertyValue.Key);
+        if (PlanEntry == nullptr || (bSkipOffGameThreadProperties && PlanEntry->bCanDecodeOffGameThread)) continue;
 
-        const TSharedPtr<FJsonValue> PropertyJsonValue = PropertyValues->Values.FindChecked(Property->GetName());
-        if (Property->ArrayDim != 1)
+        uint8* PropertyValuePtr = static_cast<uint8*>(StructData) + PlanEntry->Offset;
+        if (PlanEntry->ArrayDim != 1)
         {
             // Handle static array properties here to avoid special handling in DeserializePropertyValue
-            const TArray<TSharedPtr<FJsonValue>>& StaticArrayPropertyJsonValues = PropertyJsonValue->AsArray();
-            for (int32 ArrayIndex = 0; ArrayIndex < FMath::Min(Property->ArrayDim, StaticArrayPropertyJsonValues.Num()); ArrayIndex++)
+            const TArray<TSharedPtr<FJsonValue>>& StaticArrayPropertyJsonValues = PropertyValue.Value->AsArray();
+            for (int32 ArrayIndex = 0; ArrayIndex < FMath::Min(PlanEntry->ArrayDim, StaticArrayPropertyJsonValues.Num()); ArrayIndex++)
             {
-                void* ElementValuePtr = Property->ContainerPtrToValuePtr<void>(StructData, ArrayIndex);
-                const TSharedPtr<FJsonValue> ElementJsonValue = StaticArrayPropertyJsonValues[ArrayIndex];
-                DeserializePropertyValue(Property, ElementValuePtr, ElementJsonValue);
+                void* ElementValuePtr = PropertyValuePtr + ArrayIndex * PlanEntry->ElementSize;
+                DeserializePropertyValueWithHandler(PlanEntry->Handler, PlanEntry->Property, ElementValuePtr, StaticArrayPropertyJsonValues[ArrayIndex]);
             }
         }
         else
         {
             // This is a normal non-static-array property that can be serialized through DeserializePropertyValue
-            void* PropertyValuePtr = Property->ContainerPtrToValuePtr<void>(StructData);
-            DeserializePropertyValue(Property, PropertyValuePtr, PropertyJsonValue);
+            DeserializePropertyValueWithHandler(PlanEntry->Handler, PlanEntry->Property, PropertyValuePtr, PropertyValue.Value);
         }
     }
 }
@@ -1329,14 +2569,73 @@ UClass* FSuziePluginModule::GetNativeParentClassForDynamicClass(const UClass* In
 UClass* FSuziePluginModule::GetDynamicParentClassForBlueprintClass(UClass* InBlueprintClass)
 {
     // Find the polymorphic class we are currently constructing, in case this is a derived blueprint class
+    // Blueprint classes inherit the class constructor from their parent, but unlike dynamic classes they are not marked as native
     UClass* CurrentClass = InBlueprintClass;
-    while (CurrentClass->ClassConstructor == &FSuziePluginModule::PolymorphicClassConstructorInvocationHelper && !DynamicClassConstructionData.Contains(CurrentClass))
+    while (CurrentClass->ClassConstructor == &FSuziePluginModule::PolymorphicClassConstructorInvocationHelper && !CurrentClass->HasAnyClassFlags(CLASS_Native))
     {
         CurrentClass = CurrentClass->GetSuperClass();
     }
     return CurrentClass;
 }
 
+const FDynamicClassFlattenedConstructionData* FSuziePluginModule::GetFlattenedConstructionData(const UClass* DynamicClass)
+{
+    // Pairs with the release store in PublishFlattenedConstructionData, so the contents of the data are visible to the constructing thread
+    return GetFlattenedConstructionDataSlot(DynamicClass).load(std::memory_order_acquire);
+}
+
+void FSuziePluginModule::PublishFlattenedConstructionData(UClass* DynamicClass, TUniquePtr<FDynamicClassFlattenedConstructionData> FlattenedData)
+{
+    check(IsInGameThread());
+    GetFlattenedConstructionDataSlot(DynamicClass).store(FlattenedData.Get(), std::memory_order_release);
+    PublishedFlattenedConstructionData.Emplace(DynamicClass, MoveTemp(FlattenedData));
+}
+
+TUniquePtr<FDynamicClassFlattenedConstructionData> FSuziePluginModule::AssembleFlattenedConstructionData(const FDynamicClassGenerationContext& Context, const FDynamicClassConstructionData& ClassConstructionData, const UClass* DynamicClass,
+    const TSet<FName>& NativeDefaultSubobjectNames)
+{
+    TUniquePtr<FDynamicClassFlattenedConstructionData> FlattenedData = MakeUnique<FDynamicClassFlattenedConstructionData>();
+    FlattenedData->NativeParentClass = GetNativeParentClassForDynamicClass(DynamicClass);
+
+    // Parent dynamic classes publish their flattened data when they are created, so it contains the properties of the rest of the hierarchy
+    // Parents that are still being created further up the stack (e.g. a parent class declaring a function that takes its child class) have not published theirs yet,
+    // so the properties of these are taken from their mutable construction data, on top of the closest parent that has published its data
+    TArray<UClass*, TInlineAllocator<8>> UnpublishedParentClasses;
+    for (UClass* ParentClass = DynamicClass->GetSuperClass(); ParentClass != FlattenedData->NativeParentClass; ParentClass = ParentClass->GetSuperClass())
+    {
+        if (const FDynamicClassFlattenedConstructionData* ParentFlattenedData = GetFlattenedConstructionData(ParentClass))
+        {
+            FlattenedData->PropertiesToConstruct = ParentFlattenedData->PropertiesToConstruct;
+            break;
+        }
+        UnpublishedParentClasses.Add(ParentClass);
+    }
+    for (int32 ParentIndex = UnpublishedParentClasses.Num() - 1; ParentIndex >= 0; ParentIndex--)
+    {
+        if (const FDynamicClassConstructionData* ParentConstructionData = Context.ClassConstructionData.Find(UnpublishedParentClasses[ParentIndex]))
+        {
+            FlattenedData->PropertiesToConstruct.Append(ParentConstructionData->PropertiesToConstruct);
+        }
+    }
+    FlattenedData->PropertiesToConstruct.Append(ClassConstructionData.PropertiesToConstruct);
+
+    // Default subobjects of the native parent can only be told apart from dynamic ones by their names collected from the native parent CDO
+    // Dynamic classes list default subobjects of their parents too, so the list of the class itself is complete and has the most derived subobject classes
+    for (const FDynamicObjectConstructionData& SubobjectConstructionData : ClassConstructionData.DefaultSubobjects)
+    {
+        const bool bCreatedByNativeParent = NativeDefaultSubobjectNames.Contains(SubobjectConstructionData.ObjectName);
+        TArray<FDynamicObjectConstructionData>& DefaultSubobjects = bCreatedByNativeParent ? FlattenedData->NativeDefaultSubobjects : FlattenedData->DynamicDefaultSubobjects;
+        if (!DefaultSubobjects.ContainsByPredicate([&](const FDynamicObjectConstructionData& Other) { return Other.ObjectName == SubobjectConstructionData.ObjectName; }))
+        {
+            DefaultSubobjects.Add(SubobjectConstructionData);
+        }
+    }
+    FlattenedData->SuppressedDefaultSubobjects = ClassConstructionData.SuppressedDefaultSubobjects;
+    FlattenedData->DefaultSubobjectOverrides = ClassConstructionData.DefaultSubobjectOverrides;
+    FlattenedData->DefaultObjectArchetype = ClassConstructionData.DefaultObjectArchetype;
+    return FlattenedData;
+}
+
 // Mirrors layout of first 3 members of FObjectInitializer
 struct FObjectInitializerAccessStub
 {
@@ -1347,33 +2646,39 @@ struct FObjectInitializerAccessStub
 
 void FSuziePluginModule::PolymorphicClassConstructorInvocationHelper(const FObjectInitializer& ObjectInitializer)
 {
-    const UClass* NativeParentClass = GetNativeParentClassForDynamicClass(ObjectInitializer.GetClass());
     const UClass* TopLevelDynamicClass = GetDynamicParentClassForBlueprintClass(ObjectInitializer.GetClass());
 
-    // We must have valid construction data for all dynamic classes
-    const FDynamicClassConstructionData* TopLevelClassConstructionData = DynamicClassConstructionData.Find(TopLevelDynamicClass);
-    checkf(TopLevelClassConstructionData, TEXT("Failed to find dynamic class construction data for dynamic class %s"), *TopLevelDynamicClass->GetPathName());
+    // We must have valid construction data for all dynamic classes. Provisional data is published when the class is created, and replaced once it is finalized
+    const FDynamicClassFlattenedConstructionData* ConstructionData = GetFlattenedConstructionData(TopLevelDynamicClass);
+    checkf(ConstructionData, TEXT("Failed to find dynamic class construction data for dynamic class %s"), *TopLevelDynamicClass->GetPathName());
+
+    // Archetype creation has been deferred until the first instance. The archetype itself and the CDO are initialized from the CDO values and do not need it
+    // The archetype is constructed before anything of this object has been initialized, under its own name, the same way a CDO is created when first accessed from a constructor
+    if (ConstructionData->bCreateDefaultObjectArchetypeOnFirstInstance && !ObjectInitializer.GetObj()->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+    {
+        ConstructionData = CreateDeferredDefaultObjectArchetype(TopLevelDynamicClass, ObjectInitializer.GetObj());
+    }
 
     // Run logic necessary for the top level dynamic class object. That includes setting up defautl subobject overrides and the active archetype to use for property copying
     {
         // If no explicit archetype has been provided for this object construction, or archetype is a CDO of the current class, set it to the default object archetype instead
         // This will ensure that correct property values are copied from the CDO for all object properties and subobjects are created using correct templates and not their CDO values
         // This has to be done before we call the parent constructor and create any default subobjects
-        if ((ObjectInitializer.GetArchetype() == nullptr || ObjectInitializer.GetArchetype() == ObjectInitializer.GetClass()->ClassDefaultObject) && TopLevelClassConstructionData->DefaultObjectArchetype)
+        if ((ObjectInitializer.GetArchetype() == nullptr || ObjectInitializer.GetArchetype() == ObjectInitializer.GetClass()->ClassDefaultObject) && ConstructionData->DefaultObjectArchetype)
         {
             FObjectInitializerAccessStub* ObjectInitializerAccess = reinterpret_cast<FObjectInitializerAccessStub*>(&ObjectInitializer.Get());
-            ObjectInitializerAccess->ObjectArchetype = TopLevelClassConstructionData->DefaultObjectArchetype;
+            ObjectInitializerAccess->ObjectArchetype = ConstructionData->DefaultObjectArchetype;
             ObjectInitializerAccess->bCopyTransientsFromClassDefaults = true; // we want to copy the transient property values from archetype as well
         }
         
         // Before we execute the class constructor of our parent native class, apply overrides to subobject types that the parent class might create
-        for (const FDynamicObjectConstructionData& SubobjectConstructionData : TopLevelClassConstructionData->DefaultSubobjects)
+        for (const FDynamicObjectConstructionData& SubobjectConstructionData : ConstructionData->NativeDefaultSubobjects)
         {
             // ReSharper disable once CppExpressionWithoutSideEffects
             ObjectInitializer.SetDefaultSubobjectClass(SubobjectConstructionData.ObjectName, SubobjectConstructionData.ObjectClass);
         }
         // Disable creation of certain subobjects that this class does not want to have
-        for (const FName& DisabledSubobjectName : TopLevelClassConstructionData->SuppressedDefaultSubobjects)
+        for (const FName& DisabledSubobjectName : ConstructionData->SuppressedDefaultSubobjects)
         {
             // ReSharper disable once CppExpressionWithoutSideEffects
             ObjectInitializer.DoNotCreateDefaultSubobject(DisabledSubobjectName);
@@ -1381,7 +2686,7 @@ void FSuziePluginModule::PolymorphicClassConstructorInvocationHelper(const FObje
         
         // Also apply overrides for nested subobject types. These are very rare but should be handled regardless
         // TODO: We do not handle disabled nested default subobjects currently. Case is extremely rare and nested subobjects are extremely rare themselves, so this can be revised later
-        for (const FNestedDefaultSubobjectOverrideData& SubobjectOverrideData : TopLevelClassConstructionData->DefaultSubobjectOverrides)
+        for (const FNestedDefaultSubobjectOverrideData& SubobjectOverrideData : ConstructionData->DefaultSubobjectOverrides)
         {
             // ReSharper disable once CppExpressionWithoutSideEffects
             ObjectInitializer.SetNestedDefaultSubobjectClass(SubobjectOverrideData.SubobjectPath, SubobjectOverrideData.OverridenClass);
@@ -1389,64 +2694,44 @@ void FSuziePluginModule::PolymorphicClassConstructorInvocationHelper(const FObje
     }
     
     // Run the constructor for that parent native class now to get an initialized object of the parent class type and parent default subobjects
-    NativeParentClass->ClassConstructor(ObjectInitializer);
-
-    // Gather all dynamic classes that contribute to the object being constructed, starting at the top level one
-    TArray<const UClass*, TInlineAllocator<8>> DynamicClassHierarchyTree;
-    const UClass* CurrentDynamicClass = TopLevelDynamicClass;
-    while (CurrentDynamicClass->ClassConstructor == &FSuziePluginModule::PolymorphicClassConstructorInvocationHelper)
-    {
-        DynamicClassHierarchyTree.Add(CurrentDynamicClass);
-        CurrentDynamicClass = CurrentDynamicClass->GetSuperClass();
-    }
+    ConstructionData->NativeParentClass->ClassConstructor(ObjectInitializer);
 
-    // Run constructors for each dynamic class in reverse order, e.g. from the furthest parent to the top level class
-    for (int32 i = DynamicClassHierarchyTree.Num() - 1; i >= 0; i--)
+    // Run property initializers for properties defined in dynamic classes that need constructor calls
+    UObject* ConstructedObject = ObjectInitializer.GetObj();
+    for (const FProperty* Property : ConstructionData->PropertiesToConstruct)
     {
-        ExecutePolymorphicClassConstructorFrameForDynamicClass(ObjectInitializer, DynamicClassHierarchyTree[i]);
+        Property->InitializeValue_InContainer(ConstructedObject);
     }
-}
-
-void FSuziePluginModule::ExecutePolymorphicClassConstructorFrameForDynamicClass(const FObjectInitializer& ObjectInitializer, const UClass* DynamicClass)
-{
-    // We must have valid construction data for all dynamic classes
-    const FDynamicClassConstructionData* ClassConstructionData = DynamicClassConstructionData.Find(DynamicClass);
-    checkf(ClassConstructionData, TEXT("Failed to find dynamic class construction data for dynamic class %s"), *DynamicClass->GetPathName());
 
-    // Run property initializers for properties defined in this class that need constructor calls
-    for (const FProperty* Property : ClassConstructionData->PropertiesToConstruct)
-    {
-        Property->InitializeValue_InContainer(ObjectInitializer.GetObj());
-    }
-    
-    // Create missing default subobjects for this dynamic class type
-    for (const FDynamicObjectConstructionData& SubobjectConstructionData : ClassConstructionData->DefaultSubobjects)
+    // Native parent class might decide not to create some of its default subobjects, in which case we have to create them ourselves
+    for (const FDynamicObjectConstructionData& SubobjectConstructionData : ConstructionData->NativeDefaultSubobjects)
     {
-        if (StaticFindObjectFast(SubobjectConstructionData.ObjectClass, ObjectInitializer.GetObj(), SubobjectConstructionData.ObjectName) == nullptr)
+        if (StaticFindObjectFast(SubobjectConstructionData.ObjectClass, ConstructedObject, SubobjectConstructionData.ObjectName) == nullptr)
         {
-            ObjectInitializer.CreateDefaultSubobject(ObjectInitializer.GetObj(),
+            ObjectInitializer.CreateDefaultSubobject(ConstructedObject,
                 SubobjectConstructionData.ObjectName, UObject::StaticClass(), SubobjectConstructionData.ObjectClass,
                 true, EnumHasAnyFlags(SubobjectConstructionData.ObjectFlags, RF_Transient));
         }
     }
+    // Default subobjects of dynamic classes are never created by anyone else
+    for (const FDynamicObjectConstructionData& SubobjectConstructionData : ConstructionData->DynamicDefaultSubobjects)
+    {
+        ObjectInitializer.CreateDefaultSubobject(ConstructedObject,
+            SubobjectConstructionData.ObjectName, UObject::StaticClass(), SubobjectConstructionData.ObjectClass,
+            true, EnumHasAnyFlags(SubobjectConstructionData.ObjectFlags, RF_Transient));
+    }
 }
 
-void FSuziePluginModule::CollectNestedDefaultSubobjectTypeOverrides(FDynamicClassGenerationContext& Context, TArray<FName> SubobjectNameStack, const FString& SubobjectPath, TArray<FNestedDefaultSubobjectOverrideData>& OutSubobjectOverrideData)
+void FSuziePluginModule::CollectNestedDefaultSubobjectTypeOverrides(const FDynamicClassGenerationContext& Context, const FDynamicClassFinalizationStaging& Staging, TArray<FName> SubobjectNameStack, const FDynamicObjectRecord& SubobjectRecord,
+    TArray<FNestedDefaultSubobjectOverrideData>& OutSubobjectOverrideData)
 {
-    const TSharedPtr<FJsonObject> ObjectDefinition = Context.GlobalObjectMap->GetObjectField(SubobjectPath);
-    checkf(ObjectDefinition.IsValid(), TEXT("Failed to find subobject object by path %s"), *SubobjectPath);
-    
     // Parse construction data for this object first. Skip if this is not a subobject
     FDynamicObjectConstructionData ObjectConstructionData;
-    if (!ParseObjectConstructionData(Context, SubobjectPath, ObjectConstructionData) || !EnumHasAnyFlags(ObjectConstructionData.ObjectFlags, RF_DefaultSubObject))
+    if (!EnumHasAnyFlags(SubobjectRecord.ObjectFlags, RF_DefaultSubObject) || !ParseObjectConstructionData(SubobjectRecord, Staging.DefaultSubobjectClasses.FindRef(&SubobjectRecord), ObjectConstructionData))
     {
         return;
     }
-    // Class of the overriden default subobject might not have been finalized yet, in which case we have to finalize it now to have its archetype with correct values
-    if (Context.ClassesPendingFinalization.Contains(ObjectConstructionData.ObjectClass))
-    {
-        FinalizeClass(Context, ObjectConstructionData.ObjectClass);
-    }
+    // Class of the overriden default subobject has been finalized before this class, see CollectFinalizationDependencies
 
     // Add the name of this object to the stack. If this is not a top level subobject, add it to the override list
     SubobjectNameStack.Add(ObjectConstructionData.ObjectName);
@@ -1456,128 +2741,538 @@ void FSuziePluginModule::CollectNestedDefaultSubobjectTypeOverrides(FDynamicClas
     }
 
     // Iterate over children and collect nested default subobject overrides for them
-    if (ObjectDefinition->HasTypedField<EJson::Array>(TEXT("children")))
+    for (const int32 ChildRecordIndex : SubobjectRecord.Children)
     {
-        const TArray<TSharedPtr<FJsonValue>>& Children = ObjectDefinition->GetArrayField(TEXT("children"));
-        for (const TSharedPtr<FJsonValue>& ChildJsonValue : Children)
-        {
-            // CollectNestedDefaultSubobjectTypeOverrides will discard children that are not actually subobjects
-            const FString ChildPath = ChildJsonValue->AsString();
-            CollectNestedDefaultSubobjectTypeOverrides(Context, SubobjectNameStack, ChildPath, OutSubobjectOverrideData);
-        }
+        // CollectNestedDefaultSubobjectTypeOverrides will discard children that are not actually subobjects
+        CollectNestedDefaultSubobjectTypeOverrides(Context, Staging, SubobjectNameStack, Context.ObjectRecords[ChildRecordIndex], OutSubobjectOverrideData);
     }
 }
 
-void FSuziePluginModule::DeserializeObjectAndSubobjectPropertyValuesRecursive(const FDynamicClassGenerationContext& Context, UObject* Object, const TSharedPtr<FJsonObject>& ObjectDefinition)
+void FSuziePluginModule::DeserializeObjectAndSubobjectPropertyValuesRecursive(const FDynamicClassGenerationContext& Context, UObject* Object, const FDynamicObjectRecord& ObjectRecord,
+    const TMap<const FDynamicObjectRecord*, FDynamicStagedObjectPropertyValues>* StagedPropertyValues)
 {
+    // Values decoded ahead of time can only be used if the object has been created with the class they have been decoded for
+    const FDynamicStagedObjectPropertyValues* StagedObjectPropertyValues = StagedPropertyValues ? StagedPropertyValues->Find(&ObjectRecord) : nullptr;
+    if (StagedObjectPropertyValues && StagedObjectPropertyValues->Struct != Object->GetClass())
+    {
+        StagedObjectPropertyValues = nullptr;
+    }
+
     // Deserialize property values for this object first
-    if (ObjectDefinition->HasTypedField<EJson::Object>(TEXT("property_values")))
+    const TSharedPtr<FJsonObject>* PropertyValues;
+    if (ObjectRecord.Definition->TryGetObjectField(TEXT("property_values"), PropertyValues))
     {
-        const TSharedPtr<FJsonObject> PropertyValues = ObjectDefinition->GetObjectField(TEXT("property_values"));
-        DeserializeStructProperties(Object->GetClass(), Object, PropertyValues);
+        if (StagedObjectPropertyValues)
+        {
+            ApplyStagedPropertyValues(Object, *StagedObjectPropertyValues);
+        }
+        DeserializeStructProperties(Object->GetClass(), Object, *PropertyValues, StagedObjectPropertyValues != nullptr);
     }
 
     // Iterate over children and deserialize values for the ones that already exist as default subobjects
-    if (ObjectDefinition->HasTypedField<EJson::Array>(TEXT("children")))
+    for (const int32 ChildRecordIndex : ObjectRecord.Children)
     {
-        const TArray<TSharedPtr<FJsonValue>>& Children = ObjectDefinition->GetArrayField(TEXT("children"));
-        for (const TSharedPtr<FJsonValue>& ChildJsonValue : Children)
+        const FDynamicObjectRecord& ChildRecord = Context.ObjectRecords[ChildRecordIndex];
+
+        // Parse object construction data and check if it is a default subobject
+        FDynamicObjectConstructionData ObjectConstructionData;
+        if (EnumHasAnyFlags(ChildRecord.ObjectFlags, RF_DefaultSubObject) && ParseObjectConstructionData(Context, ChildRecord, ObjectConstructionData))
+        {
+            UObject* SubobjectInstance = StaticFindObjectFast(ObjectConstructionData.ObjectClass, Object, ObjectConstructionData.ObjectName);
+
+            // If we have a constructed subobject instance, deserialize the properties into that instance
+            if (SubobjectInstance && SubobjectInstance->HasAnyFlags(RF_DefaultSubObject))
+            {
+                DeserializeObjectAndSubobjectPropertyValuesRecursive(Context, SubobjectInstance, ChildRecord, StagedPropertyValues);
+            }
+        }
+    }
+}
+
+// Approximate memory used by the object and all of its subobjects, not including memory allocated by their properties
+static int64 GetObjectAndSubobjectsSize(const UObject* Object)
+{
+    int64 TotalSize = Object->GetClass()->GetStructureSize();
+    ForEachObjectWithOuter(Object, [&](const UObject* Subobject)
+    {
+        TotalSize += Subobject->GetClass()->GetStructureSize();
+    }, true);
+    return TotalSize;
+}
+
+// Copies property values of the default subobjects of the source object into the matching default subobjects of the destination object, recursively
+// Transient properties keep the values they have been constructed with, like they would when the object is duplicated
+static void CopyDefaultSubobjectPropertyValues(const UObject* SourceObject, UObject* DestinationObject, TMap<UObject*, UObject*>& OutSubobjectMap)
+{
+    ForEachObjectWithOuter(SourceObject, [&](UObject* SourceSubobject)
+    {
+        if (!SourceSubobject->HasAnyFlags(RF_DefaultSubObject))
+        {
+            return;
+        }
+        UObject* DestinationSubobject = StaticFindObjectFast(SourceSubobject->GetClass(), DestinationObject, SourceSubobject->GetFName());
+        if (DestinationSubobject == nullptr)
+        {
+            return;
+        }
+        for (const FProperty* Property = SourceSubobject->GetClass()->PropertyLink; Property; Property = Property->PropertyLinkNext)
         {
-            const FString ChildPath = ChildJsonValue->AsString();
-            
-            // Parse object construction data and check if it is a default subobject
-            FDynamicObjectConstructionData ObjectConstructionData;
-            if (ParseObjectConstructionData(Context, ChildPath, ObjectConstructionData) && EnumHasAnyFlags(ObjectConstructionData.ObjectFlags, RF_DefaultSubObject))
+            if (!Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient | CPF_NonPIEDuplicateTransient))
             {
-                const TSharedPtr<FJsonObject> SubobjectDefinition = Context.GlobalObjectMap->GetObjectField(ChildPath);
-                UObject* SubobjectInstance = StaticFindObjectFast(ObjectConstructionData.ObjectClass, Object, ObjectConstructionData.ObjectName);
+                Property->CopyCompleteValue_InContainer(DestinationSubobject, SourceSubobject);
+            }
+        }
+        OutSubobjectMap.Add(SourceSubobject, DestinationSubobject);
+        CopyDefaultSubobjectPropertyValues(SourceSubobject, DestinationSubobject, OutSubobjectMap);
+    }, false);
+}
+
+UObject* FSuziePluginModule::CreateDefaultObjectArchetype(UClass* DynamicClass, UObject* ClassDefaultObject, const bool bDuplicate)
+{
+    SUZIE_SCOPED_PHASE(ArchetypeCreation);
+    const FString ArchetypeObjectName = TEXT("InitializationArchetype__") + DynamicClass->GetName();
+
+    UObject* DefaultObjectArchetype;
+    if (bDuplicate)
+    {
+        FScopedAllowAbstractClassAllocation AllowAbstract;
+        DefaultObjectArchetype = DuplicateObject(ClassDefaultObject, ClassDefaultObject->GetOuter(), *ArchetypeObjectName);
+        DefaultObjectArchetype->ClearFlags(RF_ClassDefaultObject);
+        DefaultObjectArchetype->SetFlags(RF_Public | RF_ArchetypeObject | RF_Transactional);
+    }
+    else
+    {
+        // Construct the archetype with the CDO as its template. Copying transients from class defaults makes the object initializer copy every property from the CDO,
+        // including the ones declared by native classes, which it would otherwise skip for native classes
+        FStaticConstructObjectParameters ConstructObjectParameters(DynamicClass);
+        ConstructObjectParameters.Outer = ClassDefaultObject->GetOuter();
+        ConstructObjectParameters.Name = *ArchetypeObjectName;
+        ConstructObjectParameters.SetFlags = RF_Public | RF_ArchetypeObject | RF_Transactional;
+        ConstructObjectParameters.Template = ClassDefaultObject;
+        ConstructObjectParameters.bCopyTransientsFromClassDefaults = true;
+        {
+            FScopedAllowAbstractClassAllocation AllowAbstract;
+            DefaultObjectArchetype = StaticConstructObject_Internal(ConstructObjectParameters);
+        }
+
+        // Default subobjects are not initialized from the subobjects of the CDO when the template is the CDO of a native class, so copy their values over
+        TMap<UObject*, UObject*> SubobjectMap;
+        SubobjectMap.Add(ClassDefaultObject, DefaultObjectArchetype);
+        CopyDefaultSubobjectPropertyValues(ClassDefaultObject, DefaultObjectArchetype, SubobjectMap);
 
-                // If we have a constructed subobject instance, deserialize the properties into that instance
-                if (SubobjectDefinition && SubobjectInstance && SubobjectInstance->HasAnyFlags(RF_DefaultSubObject))
+        // References to the CDO and its subobjects have been copied as they are, point them to the archetype and its subobjects instead
+        for (const TPair<UObject*, UObject*>& SubobjectPair : SubobjectMap)
+        {
+            UObject* Object = SubobjectPair.Value;
+            for (TPropertyValueIterator<FObjectPropertyBase> PropertyIterator(Object->GetClass(), Object); PropertyIterator; ++PropertyIterator)
+            {
+                const FObjectPropertyBase* ObjectProperty = PropertyIterator.Key();
+                void* PropertyValuePtr = const_cast<void*>(PropertyIterator.Value());
+                if (UObject* const* ReplacementObject = SubobjectMap.Find(ObjectProperty->GetObjectPropertyValue(PropertyValuePtr)))
                 {
-                    DeserializeObjectAndSubobjectPropertyValuesRecursive(Context, SubobjectInstance, SubobjectDefinition);   
+                    ObjectProperty->SetObjectPropertyValue(PropertyValuePtr, *ReplacementObject);
                 }
             }
         }
     }
+    DefaultObjectArchetype->AddToRoot();
+
+    SUZIE_INCREMENT_COUNTER(Archetypes);
+    SUZIE_INCREMENT_COUNTER(ArchetypeBytes, GetObjectAndSubobjectsSize(DefaultObjectArchetype));
+    return DefaultObjectArchetype;
 }
 
-void FSuziePluginModule::FinalizeClass(FDynamicClassGenerationContext& Context, UClass* Class)
+const FDynamicClassFlattenedConstructionData* FSuziePluginModule::CreateDeferredDefaultObjectArchetype(const UClass* DynamicClass, const UObject* FirstInstance)
 {
-    // Skip this class if it has already been finalized as a dependency of its child class
-    if (!Context.ClassesPendingFinalization.Contains(Class))
+    const FDynamicClassFlattenedConstructionData* FlattenedData = GetFlattenedConstructionData(DynamicClass);
+
+    // Objects can only be created and construction data published on the game thread. Objects constructed on other threads before that are initialized from the CDO,
+    // which leaves their instanced subobject references pointing at the subobjects of the CDO. This should not happen, since the archetypes are created eagerly when packages are loaded on other threads
+    if (!IsInGameThread())
     {
-        return;
+        UE_LOG(LogSuzie, Warning, TEXT("Object %s of class %s constructed outside of the game thread before its archetype has been created. Set Suzie.ArchetypeStrategy to 1 if this happens"),
+            *FirstInstance->GetPathName(), *DynamicClass->GetPathName());
+        return FlattenedData;
     }
 
-    // Find the definition for the class default object
-    const FString ClassDefaultObjectPath = Context.ClassesPendingFinalization.FindAndRemoveChecked(Class);
+    UClass* MutableDynamicClass = const_cast<UClass*>(DynamicClass);
+    TUniquePtr<FDynamicClassFlattenedConstructionData> FlattenedDataWithArchetype = MakeUnique<FDynamicClassFlattenedConstructionData>(*FlattenedData);
+    FlattenedDataWithArchetype->DefaultObjectArchetype = CreateDefaultObjectArchetype(MutableDynamicClass, MutableDynamicClass->GetDefaultObject(), false);
+    FlattenedDataWithArchetype->bCreateDefaultObjectArchetypeOnFirstInstance = false;
+    PublishFlattenedConstructionData(MutableDynamicClass, MoveTemp(FlattenedDataWithArchetype));
+
+    return GetFlattenedConstructionData(DynamicClass);
+}
+
+void FSuziePluginModule::ApplyStagedPropertyValues(void* StructData, const FDynamicStagedObjectPropertyValues& StagedValues)
+{
+    for (const FDynamicStagedPropertyValue& StagedValue : StagedValues.Values)
+    {
+        const FDynamicPropertyDeserializationPlanEntry& PlanEntry = *StagedValue.PlanEntry;
+        uint8* PropertyValuePtr = static_cast<uint8*>(StructData) + PlanEntry.Offset;
+        for (int32 ArrayIndex = 0; ArrayIndex < StagedValue.NumElements; ArrayIndex++)
+        {
+            PlanEntry.Property->CopySingleValue(PropertyValuePtr + ArrayIndex * PlanEntry.ElementSize, static_cast<const uint8*>(StagedValue.Buffer) + ArrayIndex * PlanEntry.ElementSize);
+        }
+    }
+}
+
+FDynamicClassFinalizationStaging::~FDynamicClassFinalizationStaging()
+{
+    for (TPair<const FDynamicObjectRecord*, FDynamicStagedObjectPropertyValues>& ObjectPropertyValues : StagedPropertyValues)
+    {
+        for (const FDynamicStagedPropertyValue& StagedValue : ObjectPropertyValues.Value.Values)
+        {
+            StagedValue.PlanEntry->Property->DestroyValue(StagedValue.Buffer);
+            FMemory::Free(StagedValue.Buffer);
+        }
+    }
+}
 
-    // Finalize our parent class first since we require parent class CDO to be populated before CDO for this class can be created
+void FSuziePluginModule::CollectFinalizationDependencies(const FDynamicClassGenerationContext& Context, const UClass* Class, const FDynamicObjectRecord& ClassDefaultObjectRecord, TArray<UClass*>& OutDependencies)
+{
+    // Parent class CDO has to be populated before the CDO of this class can be created
     UClass* ParentClass = Class->GetSuperClass();
     if (ParentClass && Context.ClassesPendingFinalization.Contains(ParentClass))
     {
-        FinalizeClass(Context, ParentClass);
+        OutDependencies.AddUnique(ParentClass);
+    }
+
+    // Classes of default subobjects (including nested ones) need their archetypes with correct values before the subobjects can be created
+    TArray<const FDynamicObjectRecord*, TInlineAllocator<16>> SubobjectRecordStack;
+    SubobjectRecordStack.Add(&ClassDefaultObjectRecord);
+    while (!SubobjectRecordStack.IsEmpty())
+    {
+        const FDynamicObjectRecord* OuterRecord = SubobjectRecordStack.Pop();
+        for (const int32 ChildRecordIndex : OuterRecord->Children)
+        {
+            const FDynamicObjectRecord& ChildRecord = Context.ObjectRecords[ChildRecordIndex];
+            if (!EnumHasAnyFlags(ChildRecord.ObjectFlags, RF_DefaultSubObject))
+            {
+                continue;
+            }
+            UClass* SubobjectClass = FindObject<UClass>(nullptr, *ChildRecord.ClassPath.ToString());
+            if (SubobjectClass && SubobjectClass != Class && Context.ClassesPendingFinalization.Contains(SubobjectClass))
+            {
+                OutDependencies.AddUnique(SubobjectClass);
+            }
+            SubobjectRecordStack.Add(&ChildRecord);
+        }
+    }
+}
+
+void FSuziePluginModule::PrepareClassFinalization(const FDynamicClassGenerationContext& Context, FDynamicClassFinalizationStaging& Staging)
+{
+    // Default objects of native classes are created on first access, and the object hash cannot be iterated off the game thread
+    ForEachObjectWithOuter(GetNativeParentClassForDynamicClass(Staging.Class)->GetDefaultObject(), [&](const UObject* ArchetypeDefaultSubobject)
+    {
+        if (ArchetypeDefaultSubobject->HasAnyFlags(RF_DefaultSubObject))
+        {
+            Staging.NativeParentDefaultSubobjectNames.Add(ArchetypeDefaultSubobject->GetFName());
+        }
+    }, false);
+    PrepareDefaultSubobjectsRecursive(Context, Staging.Class, *Staging.ClassDefaultObjectRecord, Staging);
+}
+
+void FSuziePluginModule::PrepareDefaultSubobjectsRecursive(const FDynamicClassGenerationContext& Context, const UStruct* Struct, const FDynamicObjectRecord& ObjectRecord, FDynamicClassFinalizationStaging& Staging)
+{
+    FindOrCreateStructDeserializationPlan(Struct);
+    for (const int32 ChildRecordIndex : ObjectRecord.Children)
+    {
+        const FDynamicObjectRecord& ChildRecord = Context.ObjectRecords[ChildRecordIndex];
+        if (EnumHasAnyFlags(ChildRecord.ObjectFlags, RF_DefaultSubObject))
+        {
+            // Classes are looked up by path here because the object hash cannot be accessed off the game thread either
+            UClass* SubobjectClass = FindObject<UClass>(nullptr, *ChildRecord.ClassPath.ToString());
+            Staging.DefaultSubobjectClasses.Add(&ChildRecord, SubobjectClass);
+            if (SubobjectClass)
+            {
+                PrepareDefaultSubobjectsRecursive(Context, SubobjectClass, ChildRecord, Staging);
+            }
+        }
     }
+}
 
-    const TSharedPtr<FJsonObject> ClassDefaultObjectDefinition = Context.GlobalObjectMap->GetObjectField(ClassDefaultObjectPath);
-    checkf(ClassDefaultObjectDefinition.IsValid(), TEXT("Failed to find default object by path %s"), *ClassDefaultObjectPath);
+void FSuziePluginModule::StageClassFinalization(const FDynamicClassGenerationContext& Context, FDynamicClassFinalizationStaging& Staging)
+{
+    const UClass* Class = Staging.Class;
+    if (const FDynamicClassConstructionData* ClassConstructionData = Context.ClassConstructionData.Find(Staging.Class))
+    {
+        Staging.ConstructionData = *ClassConstructionData;
+    }
 
     // Iterate child objects of the class default object to find default subobjects that we want to construct before we deserialize the data
-    FDynamicClassConstructionData& ClassConstructionData = DynamicClassConstructionData.FindOrAdd(Class);
     TSet<FName> CreatedDefaultSubobjects;
-    
-    const TArray<TSharedPtr<FJsonValue>>& Children = ClassDefaultObjectDefinition->GetArrayField(TEXT("children"));
-    for (const TSharedPtr<FJsonValue>& ChildObjectPathValue : Children)
+    for (const int32 ChildRecordIndex : Staging.ClassDefaultObjectRecord->Children)
     {
-        FString ChildPath = ChildObjectPathValue->AsString();
+        const FDynamicObjectRecord& ChildRecord = Context.ObjectRecords[ChildRecordIndex];
         FDynamicObjectConstructionData ChildObjectConstructionData;
-        if (ParseObjectConstructionData(Context, ChildPath, ChildObjectConstructionData) && EnumHasAnyFlags(ChildObjectConstructionData.ObjectFlags, RF_DefaultSubObject))
+        if (EnumHasAnyFlags(ChildRecord.ObjectFlags, RF_DefaultSubObject) && ParseObjectConstructionData(ChildRecord, Staging.DefaultSubobjectClasses.FindRef(&ChildRecord), ChildObjectConstructionData))
         {
-            // Class of our default subobject might not have been finalized yet, in which case we have to finalize it now to have its archetype with correct values
-            if (Context.ClassesPendingFinalization.Contains(ChildObjectConstructionData.ObjectClass))
-            {
-                FinalizeClass(Context, ChildObjectConstructionData.ObjectClass);
-            }
-            ClassConstructionData.DefaultSubobjects.Add(ChildObjectConstructionData);
+            Staging.ConstructionData.DefaultSubobjects.Add(ChildObjectConstructionData);
             CreatedDefaultSubobjects.Add(ChildObjectConstructionData.ObjectName);
-            
+
             // Collect subobject overrides for this subobject
-            CollectNestedDefaultSubobjectTypeOverrides(Context, TArray<FName>(), ChildPath, ClassConstructionData.DefaultSubobjectOverrides);
+            CollectNestedDefaultSubobjectTypeOverrides(Context, Staging, TArray<FName>(), ChildRecord, Staging.ConstructionData.DefaultSubobjectOverrides);
         }
     }
 
     // Iterate default subobjects of our parent native class. If we have not created one of them, it means it has been explicitly disabled
     // TODO: This does not handle disabled nested default subobjects.
-    const UClass* NativeParentClass = GetNativeParentClassForDynamicClass(Class);
-    ForEachObjectWithOuter(NativeParentClass->GetDefaultObject(), [&](const UObject* ArchetypeDefaultSubobject)
+    for (const FName& NativeDefaultSubobjectName : Staging.NativeParentDefaultSubobjectNames)
     {
-        if (ArchetypeDefaultSubobject->HasAnyFlags(RF_DefaultSubObject) && !CreatedDefaultSubobjects.Contains(ArchetypeDefaultSubobject->GetFName()))
+        if (!CreatedDefaultSubobjects.Contains(NativeDefaultSubobjectName))
         {
-            ClassConstructionData.SuppressedDefaultSubobjects.Add(ArchetypeDefaultSubobject->GetFName());
+            Staging.ConstructionData.SuppressedDefaultSubobjects.Add(NativeDefaultSubobjectName);
         }
-    }, false);
-    
+    }
+
+    // Flatten the construction data of this class and its dynamic parents for the polymorphic constructor to use
+    Staging.FlattenedConstructionData = AssembleFlattenedConstructionData(Context, Staging.ConstructionData, Class, Staging.NativeParentDefaultSubobjectNames);
+
+    // Decode the property values that do not need the default object to exist yet
+    SUZIE_SCOPED_PHASE(PropertyDeserialization);
+    StagePropertyValuesRecursive(Context, Class, *Staging.ClassDefaultObjectRecord, Staging);
+}
+
+void FSuziePluginModule::StagePropertyValuesRecursive(const FDynamicClassGenerationContext& Context, const UStruct* Struct, const FDynamicObjectRecord& ObjectRecord, FDynamicClassFinalizationStaging& Staging)
+{
+    // Plans and subobject classes have been resolved by PrepareClassFinalization, values of objects without a plan are decoded on the game thread
+    const FDynamicStructDeserializationPlan* Plan = FindStructDeserializationPlan(Struct);
+    const TSharedPtr<FJsonObject>* PropertyValues;
+    if (Plan && ObjectRecord.Definition->TryGetObjectField(TEXT("property_values"), PropertyValues))
+    {
+        FDynamicStagedObjectPropertyValues& StagedObjectPropertyValues = Staging.StagedPropertyValues.Add(&ObjectRecord);
+        StagedObjectPropertyValues.Struct = Struct;
+
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& PropertyValue : (*PropertyValues)->Values)
+        {
+            const FDynamicPropertyDeserializationPlanEntry* PlanEntry = Plan->PropertiesByName.Find(PropertyValue.Key);
+            if (PlanEntry == nullptr || !PlanEntry->bCanDecodeOffGameThread) continue;
+
+            FDynamicStagedPropertyValue& StagedValue = StagedObjectPropertyValues.Values.AddDefaulted_GetRef();
+            StagedValue.PlanEntry = PlanEntry;
+            StagedValue.Buffer = FMemory::Malloc(PlanEntry->ElementSize * PlanEntry->ArrayDim, PlanEntry->Property->GetMinAlignment());
+            PlanEntry->Property->InitializeValue(StagedValue.Buffer);
+
+            if (PlanEntry->ArrayDim != 1)
+            {
+                const TArray<TSharedPtr<FJsonValue>>& StaticArrayPropertyJsonValues = PropertyValue.Value->AsArray();
+                StagedValue.NumElements = FMath::Min(PlanEntry->ArrayDim, StaticArrayPropertyJsonValues.Num());
+                for (int32 ArrayIndex = 0; ArrayIndex < StagedValue.NumElements; ArrayIndex++)
+                {
+                    void* ElementValuePtr = static_cast<uint8*>(StagedValue.Buffer) + ArrayIndex * PlanEntry->ElementSize;
+                    DeserializePropertyValueWithHandler(PlanEntry->Handler, PlanEntry->Property, ElementValuePtr, StaticArrayPropertyJsonValues[ArrayIndex]);
+                }
+            }
+            else
+            {
+                StagedValue.NumElements = 1;
+                DeserializePropertyValueWithHandler(PlanEntry->Handler, PlanEntry->Property, StagedValue.Buffer, PropertyValue.Value);
+            }
+        }
+    }
+
+    for (const int32 ChildRecordIndex : ObjectRecord.Children)
+    {
+        const FDynamicObjectRecord& ChildRecord = Context.ObjectRecords[ChildRecordIndex];
+        if (EnumHasAnyFlags(ChildRecord.ObjectFlags, RF_DefaultSubObject))
+        {
+            if (const UClass* SubobjectClass = Staging.DefaultSubobjectClasses.FindRef(&ChildRecord))
+            {
+                StagePropertyValuesRecursive(Context, SubobjectClass, ChildRecord, Staging);
+            }
+        }
+    }
+}
+
+void FSuziePluginModule::CompleteClassFinalization(FDynamicClassGenerationContext& Context, FDynamicClassFinalizationStaging& Staging)
+{
+    UClass* Class = Staging.Class;
+
     // Assemble reference token stream for garbage collector
     Class->AssembleReferenceTokenStream(true);
+
+    // Classes finalized on demand have already published their data before finalizing their dependencies, see FinalizeClass
+    if (Staging.FlattenedConstructionData.IsValid())
+    {
+        PublishFlattenedConstructionData(Class, MoveTemp(Staging.FlattenedConstructionData));
+    }
+
     // Create class default object now that we have class object construction data
-    UObject* ClassDefaultObject = Class->GetDefaultObject(true);
+    UObject* ClassDefaultObject;
+    {
+        SUZIE_SCOPED_PHASE(DefaultObjectCreation);
+        ClassDefaultObject = Class->GetDefaultObject(true);
+        SUZIE_INCREMENT_COUNTER(DefaultObjects);
+    }
 
     // Recursively deserialize property values for the default object and its subobjects (and their nested subobjects)
-    DeserializeObjectAndSubobjectPropertyValuesRecursive(Context, ClassDefaultObject, ClassDefaultObjectDefinition);
+    {
+        SUZIE_SCOPED_PHASE(PropertyDeserialization);
+        DeserializeObjectAndSubobjectPropertyValuesRecursive(Context, ClassDefaultObject, *Staging.ClassDefaultObjectRecord, &Staging.StagedPropertyValues);
+    }
 
-    // Create an archetype by duplicating the CDO. We will use that archetype instead of CDO for priming the instances with correct values
+    // Create an archetype from the CDO. We will use that archetype instead of CDO for priming the instances with correct values
     // Do not create archetypes for NetConnection-derived classes, they have faulty shutdown logic leading to a crash on exit
     if (!Class->IsChildOf<UNetConnection>())
     {
-        const FString ArchetypeObjectName = TEXT("InitializationArchetype__") + Class->GetName();
+        // Instances constructed by the async loading thread cannot create the deferred archetype, and would be initialized like native objects, so create it eagerly instead
+        int32 ArchetypeStrategy = CVarSuzieArchetypeStrategy.GetValueOnGameThread();
+        if (ArchetypeStrategy == 2 && IsAsyncLoadingMultithreaded())
         {
-            FScopedAllowAbstractClassAllocation AllowAbstract;
-            ClassConstructionData.DefaultObjectArchetype = DuplicateObject(ClassDefaultObject, ClassDefaultObject->GetOuter(), *ArchetypeObjectName);
+            UE_LOG(LogSuzie, Verbose, TEXT("Creating archetype of %s eagerly because packages are loaded on the async loading thread"), *Class->GetPathName());
+            ArchetypeStrategy = 1;
+        }
+        TUniquePtr<FDynamicClassFlattenedConstructionData> FlattenedDataWithArchetype = MakeUnique<FDynamicClassFlattenedConstructionData>(*GetFlattenedConstructionData(Class));
+        if (ArchetypeStrategy == 2)
+        {
+            FlattenedDataWithArchetype->bCreateDefaultObjectArchetypeOnFirstInstance = true;
+            SUZIE_INCREMENT_COUNTER(DeferredArchetypes);
+            SUZIE_INCREMENT_COUNTER(DeferredArchetypeBytes, GetObjectAndSubobjectsSize(ClassDefaultObject));
+        }
+        else
+        {
+            Staging.ConstructionData.DefaultObjectArchetype = CreateDefaultObjectArchetype(Class, ClassDefaultObject, ArchetypeStrategy == 0);
+            FlattenedDataWithArchetype->DefaultObjectArchetype = Staging.ConstructionData.DefaultObjectArchetype;
+        }
+
+        // Publish a copy of the construction data that uses the archetype. Objects that are being constructed right now keep using the old copy
+        PublishFlattenedConstructionData(Class, MoveTemp(FlattenedDataWithArchetype));
+    }
+
+    // Class is fully generated now, so the mutable construction data is no longer needed
+    Context.ClassConstructionData.Remove(Class);
+}
+
+void FSuziePluginModule::FinalizeClass(FDynamicClassGenerationContext& Context, UClass* Class)
+{
+    // Skip this class if it has already been finalized as a dependency of its child class
+    if (!Context.ClassesPendingFinalization.Contains(Class))
+    {
+        return;
+    }
+
+    // Find the definition for the class default object
+    const FName ClassDefaultObjectPath = Context.ClassesPendingFinalization.FindAndRemoveChecked(Class);
+    const FDynamicObjectRecord* ClassDefaultObjectRecord = Context.FindObjectRecord(ClassDefaultObjectPath);
+    checkf(ClassDefaultObjectRecord, TEXT("Failed to find default object by path %s"), *ClassDefaultObjectPath.ToString());
+
+    // Parent class is finalized first, so that its flattened construction data is complete before ours is assembled from it
+    FinalizeClass(Context, Class->GetSuperClass());
+
+    // Publish the complete construction data of this class before finalizing its other dependencies. A default subobject can be of a child class of this class,
+    // and creating the default object of the child class creates the default object of this class through its super class, which needs our default subobjects
+    FDynamicClassFinalizationStaging Staging;
+    Staging.Class = Class;
+    Staging.ClassDefaultObjectRecord = ClassDefaultObjectRecord;
+    PrepareClassFinalization(Context, Staging);
+    StageClassFinalization(Context, Staging);
+    PublishFlattenedConstructionData(Class, MoveTemp(Staging.FlattenedConstructionData));
+
+    // Finalize the classes of our default subobjects first, unless they are already being finalized further up the stack
+    TArray<UClass*> Dependencies;
+    CollectFinalizationDependencies(Context, Class, *ClassDefaultObjectRecord, Dependencies);
+    for (UClass* Dependency : Dependencies)
+    {
+        FinalizeClass(Context, Dependency);
+    }
+    CompleteClassFinalization(Context, Staging);
+}
+
+void FSuziePluginModule::FinalizePendingClasses(FDynamicClassGenerationContext& Context)
+{
+    TArray<UClass*> Classes;
+    Context.ClassesPendingFinalization.GenerateKeyArray(Classes);
+
+    TMap<const UClass*, int32> ClassIndices;
+    ClassIndices.Reserve(Classes.Num());
+    for (int32 ClassIndex = 0; ClassIndex < Classes.Num(); ClassIndex++)
+    {
+        ClassIndices.Add(Classes[ClassIndex], ClassIndex);
+    }
+
+    // Build the dependency graph up front. Each class keeps the number of dependencies that have not been finalized yet, and the list of classes depending on it
+    TArray<const FDynamicObjectRecord*> ClassDefaultObjectRecords;
+    TArray<TArray<int32>> DependentClassIndices;
+    TArray<int32> NumPendingDependencies;
+    ClassDefaultObjectRecords.SetNumUninitialized(Classes.Num());
+    DependentClassIndices.SetNum(Classes.Num());
+    NumPendingDependencies.SetNumZeroed(Classes.Num());
+
+    TArray<UClass*> Dependencies;
+    for (int32 ClassIndex = 0; ClassIndex < Classes.Num(); ClassIndex++)
+    {
+        const FName ClassDefaultObjectPath = Context.ClassesPendingFinalization.FindChecked(Classes[ClassIndex]);
+        ClassDefaultObjectRecords[ClassIndex] = Context.FindObjectRecord(ClassDefaultObjectPath);
+        checkf(ClassDefaultObjectRecords[ClassIndex], TEXT("Failed to find default object by path %s"), *ClassDefaultObjectPath.ToString());
+
+        Dependencies.Reset();
+        CollectFinalizationDependencies(Context, Classes[ClassIndex], *ClassDefaultObjectRecords[ClassIndex], Dependencies);
+        for (const UClass* Dependency : Dependencies)
+        {
+            DependentClassIndices[ClassIndices.FindChecked(Dependency)].Add(ClassIndex);
+            NumPendingDependencies[ClassIndex]++;
+        }
+    }
+
+    TArray<int32> WaveClassIndices;
+    for (int32 ClassIndex = 0; ClassIndex < Classes.Num(); ClassIndex++)
+    {
+        if (NumPendingDependencies[ClassIndex] == 0)
+        {
+            WaveClassIndices.Add(ClassIndex);
+        }
+    }
+
+    int32 NumWaves = 0;
+    TArray<TUniquePtr<FDynamicClassFinalizationStaging>> WaveStaging;
+    TArray<int32> NextWaveClassIndices;
+    while (!WaveClassIndices.IsEmpty())
+    {
+        // Everything the staging reads from UObjects has to be resolved or created on the game thread first
+        WaveStaging.Reset();
+        for (const int32 ClassIndex : WaveClassIndices)
+        {
+            TUniquePtr<FDynamicClassFinalizationStaging>& Staging = WaveStaging.Add_GetRef(MakeUnique<FDynamicClassFinalizationStaging>());
+            Staging->Class = Classes[ClassIndex];
+            Staging->ClassDefaultObjectRecord = ClassDefaultObjectRecords[ClassIndex];
+            PrepareClassFinalization(Context, *Staging);
+        }
+
+        // Classes of a wave do not depend on each other, and everything they depend on has been published by the previous waves
+        ParallelFor(WaveStaging.Num(), [&](const int32 StagingIndex)
+        {
+            StageClassFinalization(Context, *WaveStaging[StagingIndex]);
+        });
+
+        // Default objects and archetypes are created on the game thread in the order of the wave
+        NextWaveClassIndices.Reset();
+        for (int32 StagingIndex = 0; StagingIndex < WaveStaging.Num(); StagingIndex++)
+        {
+            const int32 ClassIndex = WaveClassIndices[StagingIndex];
+            Context.ClassesPendingFinalization.Remove(Classes[ClassIndex]);
+            CompleteClassFinalization(Context, *WaveStaging[StagingIndex]);
+
+            for (const int32 DependentClassIndex : DependentClassIndices[ClassIndex])
+            {
+                if (--NumPendingDependencies[DependentClassIndex] == 0)
+                {
+                    NextWaveClassIndices.Add(DependentClassIndex);
+                }
+            }
         }
-        ClassConstructionData.DefaultObjectArchetype->ClearFlags(RF_ClassDefaultObject);
-        ClassConstructionData.DefaultObjectArchetype->SetFlags(RF_Public | RF_ArchetypeObject | RF_Transactional);
-        ClassConstructionData.DefaultObjectArchetype->AddToRoot();
+        Swap(WaveClassIndices, NextWaveClassIndices);
+        NumWaves++;
+    }
+    UE_LOG(LogSuzie, Verbose, TEXT("Finalized %d classes in %d waves"), Classes.Num() - Context.ClassesPendingFinalization.Num(), NumWaves);
+
+    // Classes left at this point depend on each other (e.g. a class with a default subobject of its child class). Finalize them on demand, breaking the cycles where they are found
+    TArray<UClass*> ClassesInDependencyCycles;
+    Context.ClassesPendingFinalization.GenerateKeyArray(ClassesInDependencyCycles);
+    for (UClass* Class : ClassesInDependencyCycles)
+    {
+        FinalizeClass(Context, Class);
     }
 }
 
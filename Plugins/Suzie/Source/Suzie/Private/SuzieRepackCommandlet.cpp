@@ -0,0 +1,177 @@
+#include "SuzieRepackCommandlet.h"
+#include "SuziePlugin.h"
+#include "SuzieDecompressionHelper.h"
+#include "SuzieDumpShards.h"
+#include "SuzieFramedCompression.h"
+#include "SuzieMappedFile.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+USuzieRepackCommandlet::USuzieRepackCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+/** Splits every dump in the directory into a <DumpName>.jmapshards directory with one shard per package (or group of packages referencing each other) */
+static int32 SplitDumpsIntoShards(const FString& Directory, const bool bCompressShards, const bool bDeleteSource)
+{
+	TArray<FString> DefinitionFileNames;
+	IFileManager::Get().FindFiles(DefinitionFileNames, *(Directory / TEXT("*.jmap*")), true, false);
+
+	TSet<FString> ShardedDumpNames;
+	int32 NumFailedFiles = 0;
+	for (const FString& DefinitionFileName : DefinitionFileNames)
+	{
+		// The same dump might be present in multiple formats, it only has to be split once
+		EJsonClassDefinitionCompression Compression;
+		const FString DumpName = DefinitionFileName.Left(DefinitionFileName.Find(TEXT(".jmap"), ESearchCase::IgnoreCase, ESearchDir::FromEnd));
+		if (!FSuziePluginModule::GetJsonClassDefinitionFileCompression(DefinitionFileName, Compression) || ShardedDumpNames.Contains(DumpName))
+		{
+			continue;
+		}
+		const TSharedPtr<FJsonObject> RootObject = FSuziePluginModule::ParseJsonClassDefinitionFile(Directory / DefinitionFileName, Compression);
+		if (!RootObject.IsValid())
+		{
+			NumFailedFiles++;
+			continue;
+		}
+
+		const FString ShardDirectory = Directory / DumpName + FSuzieShardManifest::ShardDirectoryExtension;
+		IFileManager::Get().DeleteDirectory(*ShardDirectory, false, true);
+		FSuzieShardManifest Manifest;
+		if (!FSuzieShardManifest::SplitDump(*RootObject, ShardDirectory, bCompressShards, Manifest))
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Failed to split %s into shards"), *DefinitionFileName);
+			NumFailedFiles++;
+			continue;
+		}
+		ShardedDumpNames.Add(DumpName);
+
+		int32 NumImports = 0;
+		for (const FSuzieDumpShard& Shard : Manifest.Shards)
+		{
+			NumImports += Shard.Imports.Num();
+		}
+		UE_LOG(LogSuzie, Display, TEXT("Split %s into %d shards with %d cross-shard references"), *DefinitionFileName, Manifest.Shards.Num(), NumImports);
+
+		if (bDeleteSource)
+		{
+			IFileManager::Get().Delete(*(Directory / DefinitionFileName), false, true, true);
+		}
+	}
+	return NumFailedFiles == 0 ? 0 : 1;
+}
+
+int32 USuzieRepackCommandlet::Main(const FString& Params)
+{
+	FString Directory = FSuziePluginModule::GetJsonClassDefinitionDirectory();
+	FParse::Value(*Params, TEXT("Directory="), Directory);
+	if (!IFileManager::Get().DirectoryExists(*Directory))
+	{
+		UE_LOG(LogSuzie, Error, TEXT("Class definition directory %s does not exist"), *Directory);
+		return 1;
+	}
+
+	int32 FrameSize = FSuzieFramedCompression::DefaultFrameSize;
+	FParse::Value(*Params, TEXT("FrameSize="), FrameSize);
+	if (FrameSize <= 0)
+	{
+		UE_LOG(LogSuzie, Error, TEXT("Frame size has to be positive"));
+		return 1;
+	}
+	const bool bIncludeUncompressed = FParse::Param(*Params, TEXT("IncludeUncompressed"));
+	const bool bDeleteSource = FParse::Param(*Params, TEXT("DeleteSource"));
+
+	// Split the dumps per package instead of re-packing them as a whole
+	if (FParse::Param(*Params, TEXT("Shard")))
+	{
+		return SplitDumpsIntoShards(Directory, !FParse::Param(*Params, TEXT("UncompressedShards")), bDeleteSource);
+	}
+
+	TArray<FString> DefinitionFileNames;
+	IFileManager::Get().FindFiles(DefinitionFileNames, *(Directory / TEXT("*.jmap*")), true, false);
+
+	int32 NumFailedFiles = 0;
+	for (const FString& DefinitionFileName : DefinitionFileNames)
+	{
+		EJsonClassDefinitionCompression Compression;
+		if (!FSuziePluginModule::GetJsonClassDefinitionFileCompression(DefinitionFileName, Compression) ||
+			Compression == EJsonClassDefinitionCompression::FramedLZ4 || (Compression == EJsonClassDefinitionCompression::None && !bIncludeUncompressed))
+		{
+			continue;
+		}
+		const FString SourceFilePath = Directory / DefinitionFileName;
+		const FString DumpName = DefinitionFileName.Left(DefinitionFileName.Find(TEXT(".jmap"), ESearchCase::IgnoreCase, ESearchDir::FromEnd));
+		const FString RepackedFilePath = Directory / DumpName + TEXT(".jmap.lz4");
+
+		TUniquePtr<FSuzieMappedFile> SourceFile = FSuzieMappedFile::Open(SourceFilePath);
+		if (!SourceFile)
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Failed to read %s"), *DefinitionFileName);
+			NumFailedFiles++;
+			continue;
+		}
+		const TConstArrayView<uint8> SourceFileContents(SourceFile->GetData(), (int32)SourceFile->GetSize());
+
+		// Time the decompression of the source so that it can be compared against the re-packed file
+		TArray<uint8> UncompressedContents;
+		double SourceDecompressionTime = 0.0;
+		if (Compression == EJsonClassDefinitionCompression::Gzip)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			if (!FSuzieDecompressionHelper::DecompressMemoryGzip(SourceFileContents, UncompressedContents))
+			{
+				UE_LOG(LogSuzie, Error, TEXT("Failed to decompress %s as valid GZIP"), *DefinitionFileName);
+				NumFailedFiles++;
+				continue;
+			}
+			SourceDecompressionTime = FPlatformTime::Seconds() - StartTime;
+		}
+		else
+		{
+			UncompressedContents = SourceFileContents;
+		}
+
+		TArray<uint8> RepackedContents;
+		if (!FSuzieFramedCompression::CompressMemory(UncompressedContents, RepackedContents, FrameSize))
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Failed to compress %s"), *DefinitionFileName);
+			NumFailedFiles++;
+			continue;
+		}
+
+		// Make sure the archive round trips before it replaces the source file
+		TArray<uint8> RoundTripContents;
+		const double StartTime = FPlatformTime::Seconds();
+		const bool bRoundTripSucceeded = FSuzieFramedCompression::DecompressMemory(RepackedContents, RoundTripContents);
+		const double RepackedDecompressionTime = FPlatformTime::Seconds() - StartTime;
+		if (!bRoundTripSucceeded || RoundTripContents != UncompressedContents)
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Re-packed archive of %s does not match its source"), *DefinitionFileName);
+			NumFailedFiles++;
+			continue;
+		}
+
+		if (!FFileHelper::SaveArrayToFile(RepackedContents, *RepackedFilePath))
+		{
+			UE_LOG(LogSuzie, Error, TEXT("Failed to write %s"), *RepackedFilePath);
+			NumFailedFiles++;
+			continue;
+		}
+		UE_LOG(LogSuzie, Display, TEXT("Re-packed %s: %.1f MB -> %.1f MB (%.1f MB uncompressed), decompression %.3f s -> %.3f s"), *DefinitionFileName,
+			SourceFileContents.Num() / (1024.0 * 1024.0), RepackedContents.Num() / (1024.0 * 1024.0), UncompressedContents.Num() / (1024.0 * 1024.0),
+			SourceDecompressionTime, RepackedDecompressionTime);
+
+		// Source file cannot be deleted while it is still mapped
+		if (bDeleteSource)
+		{
+			SourceFile.Reset();
+			IFileManager::Get().Delete(*SourceFilePath, false, true, true);
+		}
+	}
+	return NumFailedFiles == 0 ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SuzieRepackCommandlet.generated.h"
+
+/**
+ * Re-packs gzip compressed dumps into multi-frame LZ4 archives (.jmap.lz4), which are larger on disk but decompress many times faster and in parallel.
+ * The re-packed file is preferred over the gzip file when both are present. Reports the size and the decompression time of both formats.
+ *
+ *   UnrealEditor-Cmd <Project> -run=SuzieRepack -SuzieNoStartupGeneration [-Directory=<Path>] [-FrameSize=<Bytes>] [-IncludeUncompressed] [-DeleteSource]
+ *
+ * -IncludeUncompressed also re-packs plain .jmap files to save disk space. Plain files are preferred over re-packed ones, so combine it with -DeleteSource.
+ *
+ * Split dumps into per-package shards, see FSuzieShardManifest. Shards are written as .jmap.lz4 unless -UncompressedShards is passed:
+ *   UnrealEditor-Cmd <Project> -run=SuzieRepack -SuzieNoStartupGeneration -Shard [-Directory=<Path>] [-UncompressedShards] [-DeleteSource]
+ */
+UCLASS()
+class USuzieRepackCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	USuzieRepackCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,260 @@
+#include "SuzieSyntheticDump.h"
+#include "Misc/FileHelper.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+namespace SuzieSyntheticDump
+{
+	using FJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	// Native classes the synthetic classes and their subobjects are based on. Both have to exist in every editor build
+	const TCHAR* const RootParentClassPath = TEXT("/Script/Engine.Actor");
+	const TCHAR* const SubobjectClassPath = TEXT("/Script/Engine.SceneComponent");
+
+	// Property types are cycled through in this order, covering plain data, strings, containers and nested structs
+	enum class EPropertyKind : uint8
+	{
+		Int,
+		Float,
+		Str,
+		Name,
+		IntArray,
+		Struct,
+		Num
+	};
+
+	FString GetClassName(const int32 ClassIndex)
+	{
+		return FString::Printf(TEXT("SyntheticClass_%d"), ClassIndex);
+	}
+
+	FString GetStructPath(const FSuzieSyntheticDumpSettings& Settings)
+	{
+		return Settings.PackageName + TEXT(".SyntheticStruct");
+	}
+
+	// Properties are prefixed with the class index so that they do not collide with the properties of the parent classes
+	FString GetPropertyName(const int32 ClassIndex, const int32 PropertyIndex)
+	{
+		return FString::Printf(TEXT("Class%d_Property%d"), ClassIndex, PropertyIndex);
+	}
+
+	FString GetSubobjectPath(const FSuzieSyntheticDumpSettings& Settings, const int32 ClassIndex, const int32 SubobjectIndex)
+	{
+		return FString::Printf(TEXT("%s.Default__%s:Class%d_Component%d"), *Settings.PackageName, *GetClassName(ClassIndex), ClassIndex, SubobjectIndex);
+	}
+
+	void WritePropertyDefinition(FJsonWriter& Writer, const FSuzieSyntheticDumpSettings& Settings, const FString& PropertyName, const EPropertyKind Kind)
+	{
+		static const TCHAR* const PropertyTypes[] = {TEXT("IntProperty"), TEXT("FloatProperty"), TEXT("StrProperty"), TEXT("NameProperty"), TEXT("ArrayProperty"), TEXT("StructProperty")};
+		static_assert(UE_ARRAY_COUNT(PropertyTypes) == (int32)EPropertyKind::Num);
+
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("name"), PropertyName);
+		Writer.WriteValue(TEXT("type"), PropertyTypes[(int32)Kind]);
+		Writer.WriteValue(TEXT("flags"), TEXT("CPF_Edit | CPF_BlueprintVisible"));
+		Writer.WriteValue(TEXT("array_dim"), 1);
+		if (Kind == EPropertyKind::IntArray)
+		{
+			Writer.WriteIdentifierPrefix(TEXT("inner"));
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("name"), PropertyName);
+			Writer.WriteValue(TEXT("type"), TEXT("IntProperty"));
+			Writer.WriteValue(TEXT("flags"), TEXT("CPF_None"));
+			Writer.WriteValue(TEXT("array_dim"), 1);
+			Writer.WriteObjectEnd();
+		}
+		else if (Kind == EPropertyKind::Struct)
+		{
+			Writer.WriteValue(TEXT("struct"), GetStructPath(Settings));
+		}
+		Writer.WriteObjectEnd();
+	}
+
+	void WritePropertyValue(FJsonWriter& Writer, const FString& PropertyName, const EPropertyKind Kind, const int32 Seed)
+	{
+		switch (Kind)
+		{
+		case EPropertyKind::Int:
+			Writer.WriteValue(PropertyName, Seed);
+			break;
+		case EPropertyKind::Float:
+			Writer.WriteValue(PropertyName, Seed * 0.5);
+			break;
+		case EPropertyKind::Str:
+			Writer.WriteValue(PropertyName, FString::Printf(TEXT("Value_%d"), Seed));
+			break;
+		case EPropertyKind::Name:
+			Writer.WriteValue(PropertyName, FString::Printf(TEXT("Name_%d"), Seed));
+			break;
+		case EPropertyKind::IntArray:
+			Writer.WriteArrayStart(PropertyName);
+			for (int32 ElementIndex = 0; ElementIndex < 4; ElementIndex++)
+			{
+				Writer.WriteValue(Seed + ElementIndex);
+			}
+			Writer.WriteArrayEnd();
+			break;
+		case EPropertyKind::Struct:
+			Writer.WriteObjectStart(PropertyName);
+			Writer.WriteValue(TEXT("IntValue"), Seed);
+			Writer.WriteValue(TEXT("FloatValue"), Seed * 0.25);
+			Writer.WriteValue(TEXT("NameValue"), FString::Printf(TEXT("Name_%d"), Seed));
+			Writer.WriteObjectEnd();
+			break;
+		default:
+			checkNoEntry();
+		}
+	}
+
+	void WriteStructDefinition(FJsonWriter& Writer, const FSuzieSyntheticDumpSettings& Settings)
+	{
+		Writer.WriteObjectStart(GetStructPath(Settings));
+		Writer.WriteValue(TEXT("type"), TEXT("ScriptStruct"));
+		Writer.WriteArrayStart(TEXT("properties"));
+		WritePropertyDefinition(Writer, Settings, TEXT("IntValue"), EPropertyKind::Int);
+		WritePropertyDefinition(Writer, Settings, TEXT("FloatValue"), EPropertyKind::Float);
+		WritePropertyDefinition(Writer, Settings, TEXT("NameValue"), EPropertyKind::Name);
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+	}
+
+	void WriteClassDefinition(FJsonWriter& Writer, const FSuzieSyntheticDumpSettings& Settings, const int32 ClassIndex)
+	{
+		const FString ClassPath = Settings.PackageName + TEXT(".") + GetClassName(ClassIndex);
+		const bool bDerivesFromNativeClass = ClassIndex % FMath::Max(Settings.InheritanceDepth, 1) == 0;
+
+		Writer.WriteObjectStart(ClassPath);
+		Writer.WriteValue(TEXT("type"), TEXT("Class"));
+		Writer.WriteValue(TEXT("super_struct"), bDerivesFromNativeClass ? FString(RootParentClassPath) : Settings.PackageName + TEXT(".") + GetClassName(ClassIndex - 1));
+		Writer.WriteValue(TEXT("class_default_object"), Settings.PackageName + TEXT(".Default__") + GetClassName(ClassIndex));
+		Writer.WriteArrayStart(TEXT("properties"));
+		for (int32 PropertyIndex = 0; PropertyIndex < Settings.NumPropertiesPerClass; PropertyIndex++)
+		{
+			WritePropertyDefinition(Writer, Settings, GetPropertyName(ClassIndex, PropertyIndex), (EPropertyKind)(PropertyIndex % (int32)EPropertyKind::Num));
+		}
+		Writer.WriteArrayEnd();
+		Writer.WriteArrayStart(TEXT("children"));
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+	}
+
+	void WriteDefaultObject(FJsonWriter& Writer, const FSuzieSyntheticDumpSettings& Settings, const int32 ClassIndex)
+	{
+		const FString ClassPath = Settings.PackageName + TEXT(".") + GetClassName(ClassIndex);
+
+		Writer.WriteObjectStart(Settings.PackageName + TEXT(".Default__") + GetClassName(ClassIndex));
+		Writer.WriteValue(TEXT("type"), TEXT("Object"));
+		Writer.WriteValue(TEXT("class"), ClassPath);
+		Writer.WriteValue(TEXT("object_flags"), TEXT("RF_Public | RF_ClassDefaultObject | RF_ArchetypeObject"));
+		Writer.WriteArrayStart(TEXT("children"));
+		for (int32 SubobjectIndex = 0; SubobjectIndex < Settings.NumSubobjectsPerClass; SubobjectIndex++)
+		{
+			Writer.WriteValue(GetSubobjectPath(Settings, ClassIndex, SubobjectIndex));
+		}
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectStart(TEXT("property_values"));
+		for (int32 PropertyIndex = 0; PropertyIndex < Settings.NumPropertiesPerClass; PropertyIndex++)
+		{
+			WritePropertyValue(Writer, GetPropertyName(ClassIndex, PropertyIndex), (EPropertyKind)(PropertyIndex % (int32)EPropertyKind::Num), ClassIndex + PropertyIndex);
+		}
+		Writer.WriteObjectEnd();
+		Writer.WriteObjectEnd();
+
+		for (int32 SubobjectIndex = 0; SubobjectIndex < Settings.NumSubobjectsPerClass; SubobjectIndex++)
+		{
+			Writer.WriteObjectStart(GetSubobjectPath(Settings, ClassIndex, SubobjectIndex));
+			Writer.WriteValue(TEXT("type"), TEXT("Object"));
+			Writer.WriteValue(TEXT("class"), SubobjectClassPath);
+			Writer.WriteValue(TEXT("object_flags"), TEXT("RF_Public | RF_DefaultSubObject | RF_ArchetypeObject"));
+			Writer.WriteArrayStart(TEXT("children"));
+			Writer.WriteArrayEnd();
+			Writer.WriteObjectStart(TEXT("property_values"));
+			Writer.WriteObjectEnd();
+			Writer.WriteObjectEnd();
+		}
+	}
+
+	// Parent class is a scene component with a default subobject of the child class. The child class does not create that subobject itself, since it would recurse otherwise
+	void WriteChildClassSubobject(FJsonWriter& Writer, const FSuzieSyntheticDumpSettings& Settings)
+	{
+		const FString ParentClassPath = Settings.PackageName + TEXT(".SyntheticSubobjectParent");
+		const FString ChildClassPath = Settings.PackageName + TEXT(".SyntheticSubobjectChild");
+		const FString ParentDefaultObjectPath = Settings.PackageName + TEXT(".Default__SyntheticSubobjectParent");
+		const FString ChildDefaultObjectPath = Settings.PackageName + TEXT(".Default__SyntheticSubobjectChild");
+		const FString SubobjectPath = ParentDefaultObjectPath + TEXT(":ChildComponent");
+
+		// String properties need to be constructed, so they are left zeroed if the parent default object is created without the construction data of its class
+		const auto WriteClass = [&](const FString& ClassPath, const FString& SuperStructPath, const FString& DefaultObjectPath, const TCHAR* PropertyName)
+		{
+			Writer.WriteObjectStart(ClassPath);
+			Writer.WriteValue(TEXT("type"), TEXT("Class"));
+			Writer.WriteValue(TEXT("super_struct"), SuperStructPath);
+			Writer.WriteValue(TEXT("class_default_object"), DefaultObjectPath);
+			Writer.WriteArrayStart(TEXT("properties"));
+			WritePropertyDefinition(Writer, Settings, PropertyName, EPropertyKind::Str);
+			Writer.WriteArrayEnd();
+			Writer.WriteArrayStart(TEXT("children"));
+			Writer.WriteArrayEnd();
+			Writer.WriteObjectEnd();
+		};
+		WriteClass(ParentClassPath, SubobjectClassPath, ParentDefaultObjectPath, TEXT("ParentValue"));
+		WriteClass(ChildClassPath, ParentClassPath, ChildDefaultObjectPath, TEXT("ChildValue"));
+
+		const auto WriteObject = [&](const FString& ObjectPath, const FString& ClassPath, const TCHAR* ObjectFlags, const FString& ChildPath, const int32 Seed)
+		{
+			Writer.WriteObjectStart(ObjectPath);
+			Writer.WriteValue(TEXT("type"), TEXT("Object"));
+			Writer.WriteValue(TEXT("class"), ClassPath);
+			Writer.WriteValue(TEXT("object_flags"), ObjectFlags);
+			Writer.WriteArrayStart(TEXT("children"));
+			if (!ChildPath.IsEmpty())
+			{
+				Writer.WriteValue(ChildPath);
+			}
+			Writer.WriteArrayEnd();
+			Writer.WriteObjectStart(TEXT("property_values"));
+			WritePropertyValue(Writer, TEXT("ParentValue"), EPropertyKind::Str, Seed);
+			if (ClassPath == ChildClassPath)
+			{
+				WritePropertyValue(Writer, TEXT("ChildValue"), EPropertyKind::Str, Seed + 1);
+			}
+			Writer.WriteObjectEnd();
+			Writer.WriteObjectEnd();
+		};
+		WriteObject(ParentDefaultObjectPath, ParentClassPath, TEXT("RF_Public | RF_ClassDefaultObject | RF_ArchetypeObject"), SubobjectPath, 0);
+		WriteObject(SubobjectPath, ChildClassPath, TEXT("RF_Public | RF_DefaultSubObject | RF_ArchetypeObject"), FString(), 10);
+		WriteObject(ChildDefaultObjectPath, ChildClassPath, TEXT("RF_Public | RF_ClassDefaultObject | RF_ArchetypeObject"), FString(), 20);
+	}
+}
+
+FString FSuzieSyntheticDump::Generate(const FSuzieSyntheticDumpSettings& Settings)
+{
+	using namespace SuzieSyntheticDump;
+
+	FString Document;
+	const TSharedRef<FJsonWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Document);
+
+	Writer->WriteObjectStart();
+	Writer->WriteObjectStart(TEXT("objects"));
+	WriteStructDefinition(*Writer, Settings);
+	for (int32 ClassIndex = 0; ClassIndex < Settings.NumClasses; ClassIndex++)
+	{
+		WriteClassDefinition(*Writer, Settings, ClassIndex);
+		WriteDefaultObject(*Writer, Settings, ClassIndex);
+	}
+	if (Settings.bChildClassSubobject)
+	{
+		WriteChildClassSubobject(*Writer, Settings);
+	}
+	Writer->WriteObjectEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return Document;
+}
+
+bool FSuzieSyntheticDump::GenerateToFile(const FSuzieSyntheticDumpSettings& Settings, const FString& FilePath)
+{
+	return FFileHelper::SaveStringToFile(Generate(Settings), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Shape of a generated synthetic dump */
+struct FSuzieSyntheticDumpSettings
+{
+	/** Script package that all generated objects are placed into. Has to be unique per dump loaded into the same process */
+	FString PackageName{TEXT("/Script/SuzieSynthetic")};
+	int32 NumClasses{1000};
+	/** Number of properties declared by each class, in addition to the inherited ones */
+	int32 NumPropertiesPerClass{16};
+	/** Number of default subobjects created by each class, in addition to the inherited ones */
+	int32 NumSubobjectsPerClass{2};
+	/** Length of the chains of dynamic classes deriving from each other. Each chain is rooted at a native actor class */
+	int32 InheritanceDepth{4};
+	/** Adds a component class with a default subobject of its own child class. Such classes depend on each other and are finalized on demand instead of in waves */
+	bool bChildClassSubobject{true};
+};
+
+/**
+ * Generates dumps in the jmap format with a configurable number of classes, properties and default subobjects.
+ * Only depends on engine types, so generation throughput can be measured without the game dump.
+ */
+class FSuzieSyntheticDump
+{
+public:
+	/** Returns the dump document as a condensed JSON string */
+	static FString Generate(const FSuzieSyntheticDumpSettings& Settings);
+	/** Generates the dump and writes it as an uncompressed UTF-8 jmap file */
+	static bool GenerateToFile(const FSuzieSyntheticDumpSettings& Settings, const FString& FilePath);
+};
@@ -2,23 +2,53 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "UObject/ObjectMacros.h"
 #include "Styling/SlateStyle.h"
 #include "Framework/Commands/UICommandList.h"
+#include "Containers/Ticker.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSuzie, Log, All);
 
-struct FDynamicClassGenerationContext
+struct FAssetData;
+class FSuzieShardManifest;
+class FSuzieNameTable;
+class FSuzieMappedFile;
+struct FSuzieDumpSignature;
+template<typename EnumType> class TSuzieFlagNameTable;
+
+enum class EDynamicObjectType : uint8
 {
-    // Key is the path of the object
-	TSharedPtr<FJsonObject> GlobalObjectMap;
-    // Value is the class path of the class
-    TMap<UClass*, FString> ClassesPendingConstruction;
-    // Value is the object path of the class default object
-    TMap<UClass*, FString> ClassesPendingFinalization;
-    // Lookup of dynamic classes that are currently being constructed by FindOrCreateUnregisteredClass
-    // Needed to handle edge case of re-entry when a parent class declares a function that takes a child class as an argument
-    // We do not support this case fully, but we need to track it to avoid creating the same class multiple times
-    TSet<FString> UnregisteredDynamicClassConstructionStack;
+    Class,
+    ScriptStruct,
+    Enum,
+    Function,
+    // Any other object, e.g. class default objects and their subobjects
+    Object,
+};
+
+// Pre-parsed definition of a single object from the dump
+struct FDynamicObjectRecord
+{
+    EDynamicObjectType Type{EDynamicObjectType::Object};
+    FName ObjectPath;
+    // Path of the outer object (or package) and the name of the object within it, as split by ParseObjectPath
+    FName OuterPath;
+    FName ObjectName;
+    // Path of the class of this object. Only set for objects of type Object
+    FName ClassPath;
+    // Path of the parent struct. Only set for classes and script structs that have a parent
+    FName SuperStructPath;
+    // Path of the class default object. Only set for classes
+    FName ClassDefaultObjectPath;
+    // Decoded flags. Only the flags relevant to the type of the object are set
+    EObjectFlags ObjectFlags{RF_NoFlags};
+    EClassFlags ClassFlags{CLASS_None};
+    EStructFlags StructFlags{STRUCT_NoFlags};
+    EFunctionFlags FunctionFlags{FUNC_None};
+    // Indices of the records of the children of this object
+    TArray<int32> Children;
+    // Full definition of the object, for data that is only read once (properties, property values, enum names)
+    TSharedPtr<FJsonObject> Definition;
 };
 
 struct FDynamicObjectConstructionData
@@ -48,6 +78,182 @@ struct FDynamicClassConstructionData
     UObject* DefaultObjectArchetype{};
 };
 
+// Construction data of a dynamic class merged with the construction data of its dynamic parent classes
+// Stored directly after the class object in memory, so constructing an instance of the class does not need any lookups
+// Immutable once published, since objects can be constructed from any thread (e.g. async loading). Changes are published as a new copy
+struct FDynamicClassFlattenedConstructionData
+{
+    UClass* NativeParentClass{};
+    // Properties of this class and all of its dynamic parent classes that must be constructed with InitializeValue call, starting with the furthest parent
+    TArray<const FProperty*> PropertiesToConstruct;
+    // Default subobjects that the native parent class creates and that we need to override the class of. They still need to be created if the native class did not create them
+    TArray<FDynamicObjectConstructionData> NativeDefaultSubobjects;
+    // Default subobjects that only exist in dynamic classes and can be created unconditionally. One entry per subobject
+    TArray<FDynamicObjectConstructionData> DynamicDefaultSubobjects;
+    TArray<FName> SuppressedDefaultSubobjects;
+    TArray<FNestedDefaultSubobjectOverrideData> DefaultSubobjectOverrides;
+    UObject* DefaultObjectArchetype{};
+    // Archetype has not been created yet and will be created when the first instance of the class is constructed on the game thread
+    bool bCreateDefaultObjectArchetypeOnFirstInstance{};
+};
+
+// Determines how the JSON value of the property is converted into the property value
+enum class EDynamicPropertyValueHandler : uint8
+{
+    // Property type that cannot be deserialized, the value is left untouched
+    Unsupported,
+    SoftObject,
+    Object,
+    Bool,
+    Numeric,
+    Name,
+    Str,
+    Text,
+    Enum,
+    ByteEnum,
+    Struct,
+    FieldPath,
+    Optional,
+    Array,
+    Set,
+    Map,
+};
+
+struct FDynamicPropertyDeserializationPlanEntry
+{
+    const FProperty* Property{};
+    // Offset of the property value in the struct, and the size of a single element for static array properties
+    int32 Offset{};
+    int32 ElementSize{};
+    int32 ArrayDim{1};
+    EDynamicPropertyValueHandler Handler{EDynamicPropertyValueHandler::Unsupported};
+    // Value does not reference any UObjects and replaces the previous value entirely, so it can be decoded into a separate buffer on any thread
+    bool bCanDecodeOffGameThread{};
+};
+
+// Properties of a struct (including the properties of its parents) keyed by their name. Built once per struct on first deserialization
+struct FDynamicStructDeserializationPlan
+{
+    // Keys are compared case-insensitively, same as JSON object field names
+    TMap<FString, FDynamicPropertyDeserializationPlanEntry> PropertiesByName;
+};
+
+// Property value decoded into a temporary buffer off the game thread. Copied into the object once it has been created on the game thread
+struct FDynamicStagedPropertyValue
+{
+    const FDynamicPropertyDeserializationPlanEntry* PlanEntry{};
+    // Number of leading static array elements that have values
+    int32 NumElements{};
+    void* Buffer{};
+};
+
+// Staged property values of a single object. Only valid for an object of the struct they have been decoded for
+struct FDynamicStagedObjectPropertyValues
+{
+    const UStruct* Struct{};
+    TArray<FDynamicStagedPropertyValue> Values;
+};
+
+// Data needed to finalize a dynamic class that is prepared without touching UObjects, so that classes can be prepared in parallel
+struct FDynamicClassFinalizationStaging
+{
+    UClass* Class{};
+    const FDynamicObjectRecord* ClassDefaultObjectRecord{};
+    FDynamicClassConstructionData ConstructionData;
+    TUniquePtr<FDynamicClassFlattenedConstructionData> FlattenedConstructionData;
+    // Keyed by the record of the class default object or one of its default subobjects
+    TMap<const FDynamicObjectRecord*, FDynamicStagedObjectPropertyValues> StagedPropertyValues;
+    // Resolved on the game thread before staging. Classes are keyed by the record of the default subobject, and are null if the class was not found
+    TMap<const FDynamicObjectRecord*, UClass*> DefaultSubobjectClasses;
+    TSet<FName> NativeParentDefaultSubobjectNames;
+
+    FDynamicClassFinalizationStaging() = default;
+    ~FDynamicClassFinalizationStaging();
+    UE_NONCOPYABLE(FDynamicClassFinalizationStaging);
+};
+
+struct FDynamicClassGenerationContext
+{
+    // Pre-parsed records of all objects in the dump
+    TArray<FDynamicObjectRecord> ObjectRecords;
+    // Key is the path of the object, value is the index of its record
+    TMap<FName, int32> ObjectRecordIndices;
+    // Value is the class path of the class
+    TMap<UClass*, FString> ClassesPendingConstruction;
+    // Value is the object path of the class default object
+    TMap<UClass*, FName> ClassesPendingFinalization;
+    // Construction data of the classes created by this context. Only needed until the class is finalized and its flattened construction data has been published
+    TMap<UClass*, FDynamicClassConstructionData> ClassConstructionData;
+    // Lookup of dynamic classes that are currently being constructed by FindOrCreateUnregisteredClass
+    // Needed to handle edge case of re-entry when a parent class declares a function that takes a child class as an argument
+    // We do not support this case fully, but we need to track it to avoid creating the same class multiple times
+    TSet<FString> UnregisteredDynamicClassConstructionStack;
+    // Estimated size of the parsed JSON definitions held by the records. Only tracked when Suzie.ReportJsonMemory is enabled
+    int64 JsonDefinitionBytes{};
+    // Names and split object paths of the strings that repeat across the dump, e.g. property names and types, and paths of classes
+    TUniquePtr<FSuzieNameTable> NameTable;
+
+    FDynamicClassGenerationContext();
+    ~FDynamicClassGenerationContext();
+    UE_NONCOPYABLE(FDynamicClassGenerationContext);
+
+    // Releases the parsed JSON definitions of all records and the interned names once nothing is going to be generated from them anymore
+    void ReleaseDefinitions();
+
+    FDynamicObjectRecord* FindObjectRecord(const FName ObjectPath)
+    {
+        const int32* RecordIndex = ObjectRecordIndices.Find(ObjectPath);
+        return RecordIndex ? &ObjectRecords[*RecordIndex] : nullptr;
+    }
+    const FDynamicObjectRecord* FindObjectRecord(const FName ObjectPath) const
+    {
+        const int32* RecordIndex = ObjectRecordIndices.Find(ObjectPath);
+        return RecordIndex ? &ObjectRecords[*RecordIndex] : nullptr;
+    }
+    // Paths that have never been converted to a name cannot have a record, so lookups by string do not need to add new names
+    FDynamicObjectRecord* FindObjectRecord(const FString& ObjectPath) { return FindObjectRecord(FName(*ObjectPath, FNAME_Find)); }
+    const FDynamicObjectRecord* FindObjectRecord(const FString& ObjectPath) const { return FindObjectRecord(FName(*ObjectPath, FNAME_Find)); }
+};
+
+// Compression of a class definition file, determined by its extension
+enum class EJsonClassDefinitionCompression : uint8
+{
+    // .jmap
+    None,
+    // .jmap.gz
+    Gzip,
+    // .jmap.lz4, see FSuzieFramedCompression
+    FramedLZ4,
+};
+
+struct FJsonClassDefinitionFile
+{
+    FString FileName;
+    EJsonClassDefinitionCompression Compression{};
+    // Generation context with the indexed objects of the file, or null if the file could not be read or parsed
+    TSharedPtr<FDynamicClassGenerationContext> GenerationContext;
+    // Signatures of the objects of the file, created alongside the context. Only set when hot reload is enabled
+    TSharedPtr<FSuzieDumpSignature> Signature;
+};
+
+// Objects loaded from a class definition file, used to find out what has changed when the file is modified
+struct FLoadedJsonClassDefinitionFile
+{
+    // Signatures of the objects of the file. Only set when hot reload is enabled
+    TSharedPtr<FSuzieDumpSignature> Signature;
+    // Generation context of the file when lazy class generation is enabled
+    TSharedPtr<FDynamicClassGenerationContext> LazyGenerationContext;
+};
+
+// Dump split into per-package shards, see FSuzieShardManifest. Shards are loaded on demand when lazy class generation is enabled
+struct FLazyShardedJsonClassDefinitions
+{
+    FString ShardDirectory;
+    TSharedPtr<FSuzieShardManifest> Manifest;
+    // Shards that have been loaded (or have failed to load) for lazy class generation
+    TBitArray<> LoadedShards;
+};
+
 struct FDynamicClassConstructionIntermediates
 {
     UObject* ConstructedObject{};
@@ -62,10 +268,38 @@ public:
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
 
+    // Generates the class with the given path if it is defined by a loaded dump but has not been generated yet. Only needed when lazy class generation is enabled
+    UClass* ResolveDynamicClass(const FString& ClassPath);
+
 private:
+    // Micro-benchmarks for the generation internals, exposed as console commands
+    friend class FSuzieBenchmarks;
+    // Headless generation benchmark
+    friend class USuzieGenerationCommandlet;
+    // Re-packs dumps into the multi-frame LZ4 format
+    friend class USuzieRepackCommandlet;
+    // Caches object paths split by ParseObjectPath
+    friend class FSuzieNameTable;
+    // Compares two dumps
+    friend class USuzieDumpDiffCommandlet;
+
     TSharedPtr<FUICommandList> PluginCommands;
     TSharedPtr<FSlateStyleSet> PluginStyle;
 
+    // Generation contexts retained for on-demand class generation when lazy class generation is enabled
+    TArray<TSharedPtr<FDynamicClassGenerationContext>> LazyGenerationContexts;
+    // Sharded dumps whose shards are loaded on demand when lazy class generation is enabled
+    TArray<FLazyShardedJsonClassDefinitions> LazyShardedDumps;
+    FDelegateHandle OnAssetAddedDelegateHandle;
+    // Objects loaded from each class definition file, keyed by file name
+    TMap<FString, FLoadedJsonClassDefinitionFile> LoadedDefinitionFiles;
+    // Changed class definition files that will be reloaded once they have not been modified for a while
+    TMap<FString, double> PendingHotReloadFiles;
+    FDelegateHandle DirectoryChangedDelegateHandle;
+    FTSTicker::FDelegateHandle HotReloadTickerHandle;
+    // Deserialization plans for the structs and classes that property values have been deserialized into
+    TMap<const UStruct*, TUniquePtr<FDynamicStructDeserializationPlan>> StructDeserializationPlans;
+
     UPackage* FindOrCreatePackage(FDynamicClassGenerationContext& Context, const FString& PackageName);
     static UClass* GetPlaceholderNonNativePropertyOwnerClass();
     UClass* FindOrCreateUnregisteredClass(FDynamicClassGenerationContext& Context, const FString& ClassPath);
@@ -77,23 +311,90 @@ private:
     static UClass* GetNativeParentClassForDynamicClass(const UClass* InDynamicClass);
     static UClass* GetDynamicParentClassForBlueprintClass(UClass* InBlueprintClass);
     static void PolymorphicClassConstructorInvocationHelper(const FObjectInitializer& ObjectInitializer);
-    static void ExecutePolymorphicClassConstructorFrameForDynamicClass(const FObjectInitializer& ObjectInitializer, const UClass* DynamicClass);
+    static const FDynamicClassFlattenedConstructionData* GetFlattenedConstructionData(const UClass* DynamicClass);
+    static void PublishFlattenedConstructionData(UClass* DynamicClass, TUniquePtr<FDynamicClassFlattenedConstructionData> FlattenedData);
+    static TUniquePtr<FDynamicClassFlattenedConstructionData> AssembleFlattenedConstructionData(const FDynamicClassGenerationContext& Context, const FDynamicClassConstructionData& ClassConstructionData, const UClass* DynamicClass,
+        const TSet<FName>& NativeDefaultSubobjectNames);
+    static UObject* CreateDefaultObjectArchetype(UClass* DynamicClass, UObject* ClassDefaultObject, bool bDuplicate);
+    static const FDynamicClassFlattenedConstructionData* CreateDeferredDefaultObjectArchetype(const UClass* DynamicClass, const UObject* FirstInstance);
 
-    static bool ParseObjectConstructionData(const FDynamicClassGenerationContext& Context, const FString& ObjectPath, FDynamicObjectConstructionData& ObjectConstructionData);
-    void DeserializeStructProperties(const UStruct* Struct, void* StructData, const TSharedPtr<FJsonObject>& PropertyValues);
+    static bool ParseObjectConstructionData(const FDynamicClassGenerationContext& Context, const FDynamicObjectRecord& ObjectRecord, FDynamicObjectConstructionData& ObjectConstructionData);
+    static bool ParseObjectConstructionData(const FDynamicObjectRecord& ObjectRecord, UClass* ObjectClass, FDynamicObjectConstructionData& ObjectConstructionData);
+    void DeserializeStructProperties(const UStruct* Struct, void* StructData, const TSharedPtr<FJsonObject>& PropertyValues, bool bSkipOffGameThreadProperties = false);
     static void DeserializeEnumValue(const FNumericProperty* UnderlyingProperty, void* PropertyValuePtr, const UEnum* Enum, const TSharedPtr<FJsonValue>& JsonPropertyValue);
     void DeserializePropertyValue(const FProperty* Property, void* PropertyValuePtr, const TSharedPtr<FJsonValue>& JsonPropertyValue);
-    void CollectNestedDefaultSubobjectTypeOverrides(FDynamicClassGenerationContext& Context, TArray<FName> SubobjectNameStack, const FString& SubobjectPath, TArray<FNestedDefaultSubobjectOverrideData>& OutSubobjectOverrideData);
-    void DeserializeObjectAndSubobjectPropertyValuesRecursive(const FDynamicClassGenerationContext& Context, UObject* Object, const TSharedPtr<FJsonObject>& ObjectDefinition);
+    void DeserializePropertyValueWithHandler(EDynamicPropertyValueHandler Handler, const FProperty* Property, void* PropertyValuePtr, const TSharedPtr<FJsonValue>& JsonPropertyValue);
+    static EDynamicPropertyValueHandler GetPropertyValueHandler(const FProperty* Property);
+    static bool CanDecodePropertyValueOffGameThread(EDynamicPropertyValueHandler Handler, const FProperty* Property);
+    const FDynamicStructDeserializationPlan& FindOrCreateStructDeserializationPlan(const UStruct* Struct);
+    const FDynamicStructDeserializationPlan* FindStructDeserializationPlan(const UStruct* Struct) const;
+    static void CollectNestedDefaultSubobjectTypeOverrides(const FDynamicClassGenerationContext& Context, const FDynamicClassFinalizationStaging& Staging, TArray<FName> SubobjectNameStack, const FDynamicObjectRecord& SubobjectRecord,
+        TArray<FNestedDefaultSubobjectOverrideData>& OutSubobjectOverrideData);
+    void DeserializeObjectAndSubobjectPropertyValuesRecursive(const FDynamicClassGenerationContext& Context, UObject* Object, const FDynamicObjectRecord& ObjectRecord,
+        const TMap<const FDynamicObjectRecord*, FDynamicStagedObjectPropertyValues>* StagedPropertyValues = nullptr);
+    static void ApplyStagedPropertyValues(void* StructData, const FDynamicStagedObjectPropertyValues& StagedValues);
     void FinalizeClass(FDynamicClassGenerationContext& Context, UClass* Class);
 
-    void CreateDynamicClassesForJsonObject(const TSharedPtr<FJsonObject>& RootObject);
-    void ProcessAllJsonClassDefinitions();
+    // Finalization of the pending classes in waves of classes that only depend on the classes of the previous waves
+    // Preparation of each wave runs in parallel, only the creation of the default objects runs on the game thread
+    void FinalizePendingClasses(FDynamicClassGenerationContext& Context);
+    // Pending classes that have to be finalized before the given class: its parent and the classes of its default subobjects
+    static void CollectFinalizationDependencies(const FDynamicClassGenerationContext& Context, const UClass* Class, const FDynamicObjectRecord& ClassDefaultObjectRecord, TArray<UClass*>& OutDependencies);
+    // Creates native default objects and deserialization plans, and resolves the subobject classes and native default subobjects the staging reads from. Has to run on the game thread
+    void PrepareClassFinalization(const FDynamicClassGenerationContext& Context, FDynamicClassFinalizationStaging& Staging);
+    void PrepareDefaultSubobjectsRecursive(const FDynamicClassGenerationContext& Context, const UStruct* Struct, const FDynamicObjectRecord& ObjectRecord, FDynamicClassFinalizationStaging& Staging);
+    // Assembles the construction data and decodes property values for a class whose dependencies have been finalized. Safe to call from any thread after PrepareClassFinalization
+    void StageClassFinalization(const FDynamicClassGenerationContext& Context, FDynamicClassFinalizationStaging& Staging);
+    void StagePropertyValuesRecursive(const FDynamicClassGenerationContext& Context, const UStruct* Struct, const FDynamicObjectRecord& ObjectRecord, FDynamicClassFinalizationStaging& Staging);
+    // Creates the class default object and the archetype from the staged data on the game thread
+    void CompleteClassFinalization(FDynamicClassGenerationContext& Context, FDynamicClassFinalizationStaging& Staging);
+
+    // Builds the object index for the parsed file. Does not touch UObjects and is safe to call from any thread
+    static TSharedPtr<FDynamicClassGenerationContext> CreateGenerationContextForJsonObject(const TSharedPtr<FJsonObject>& RootObject);
+    void CreateDynamicClassesForContext(const TSharedRef<FDynamicClassGenerationContext>& Context);
+    void CreateDynamicObjectForRecord(FDynamicClassGenerationContext& Context, const FDynamicObjectRecord& ObjectRecord);
+    // Remembers the objects of a loaded file for hot reload. The signature is expected to be created by the caller when hot reload is enabled, see IsHotReloadEnabled
+    void RegisterLoadedDefinitionFile(const FString& FileName, const TSharedRef<FDynamicClassGenerationContext>& Context, const TSharedPtr<FSuzieDumpSignature>& Signature);
+    void ConstructAndFinalizePendingClasses(FDynamicClassGenerationContext& Context);
+    void GenerateLazyRootClasses();
+    void ResolveAssetClassDependencies(const FAssetData& AssetData);
+    // Generates classes for all class definition files in the given directory
+    void ProcessAllJsonClassDefinitions(const FString& JsonClassesPath);
+    // Generates classes for the shards of a sharded dump in dependency order, holding at most two parsed shards in memory at a time
+    void ProcessShardedJsonClassDefinitions(const FString& ShardDirectory, const TSharedRef<FSuzieShardManifest>& Manifest);
+    // Loads the shard defining the given object for lazy class generation. Returns false if there is no such shard, or it has already been loaded
+    bool LoadShardForObjectPath(const FString& ObjectPath);
+    bool LoadShardForLazyGeneration(FLazyShardedJsonClassDefinitions& ShardedDump, int32 ShardIndex);
+    static bool IsHotReloadEnabled();
+    void StartWatchingJsonClassDefinitions();
+    void StopWatchingJsonClassDefinitions();
+    void OnJsonClassDefinitionDirectoryChanged(const TArray<struct FFileChangeData>& FileChanges);
+    bool TickPendingHotReloads(float DeltaTime);
+    void HotReloadJsonClassDefinitionFile(const FString& FileName);
+    static FString GetJsonClassDefinitionDirectory();
+    // Reads a single class definition file and indexes its objects, from the pre-compiled cache if it is up to date. Does not touch UObjects and is safe to call from any thread
+    static TSharedPtr<FDynamicClassGenerationContext> LoadJsonClassDefinitionFile(const FString& FilePath, EJsonClassDefinitionCompression Compression);
+    // Reads, decompresses and parses a single class definition file, ignoring the cache. Does not touch UObjects and is safe to call from any thread
+    static TSharedPtr<FJsonObject> ParseJsonClassDefinitionFile(const FString& FilePath, EJsonClassDefinitionCompression Compression);
+    static TSharedPtr<FJsonObject> ParseJsonClassDefinitionFileContents(const FString& FileName, TUniquePtr<FSuzieMappedFile> SourceFile, EJsonClassDefinitionCompression Compression);
+    // Returns false if the file name does not have one of the class definition file extensions
+    static bool GetJsonClassDefinitionFileCompression(const FString& FileName, EJsonClassDefinitionCompression& OutCompression);
+    // Parses a JSON document from a raw buffer. UTF-8 documents are parsed in place without converting them into a string first
+    static TSharedPtr<FJsonObject> ParseJsonObjectFromBuffer(const uint8* Data, int64 Size);
 
-    static void ParseObjectPath(const FString& ObjectPath, FString& OutOuterObjectPath, FString& OutObjectName);
-    static TSet<FString> ParseFlags(const FString& Flags);
+    static void ParseObjectPath(FStringView ObjectPath, FStringView& OutOuterObjectPath, FStringView& OutObjectName);
+    static const TSuzieFlagNameTable<EPropertyFlags>& GetPropertyFlagNameTable();
+    static EPropertyFlags ParsePropertyFlags(const FString& Flags);
+    static EClassFlags ParseClassFlags(const FString& Flags);
+    static EStructFlags ParseStructFlags(const FString& Flags);
+    static EFunctionFlags ParseFunctionFlags(const FString& Flags);
+    static EObjectFlags ParseObjectFlags(const FString& Flags);
 
-    FProperty* AddPropertyToStruct(FDynamicClassGenerationContext& Context, UStruct* Struct, const TSharedPtr<FJsonObject>& PropertyJson, EPropertyFlags ExtraPropertyFlags = CPF_None);
+    // Creates the described properties and appends all of them to the property list of the struct at once. Properties can be reordered by alignment if enabled
+    TArray<FProperty*> AddPropertiesToStruct(FDynamicClassGenerationContext& Context, UStruct* Struct, const TArray<TSharedPtr<FJsonValue>>& PropertyDescriptors,
+        EPropertyFlags ExtraPropertyFlags = CPF_None, bool bAllowReordering = false);
+    // Assigns offsets to the properties of a native dynamic class in a single pass, since StaticLink does not relink existing properties of native classes
+    static void LayoutNativeClassProperties(UClass* Class, TConstArrayView<FProperty*> Properties);
     void AddFunctionToClass(FDynamicClassGenerationContext& Context, UClass* Class, const FString& FunctionPath, EFunctionFlags ExtraFunctionFlags = FUNC_None);
 
     FProperty* BuildProperty(FDynamicClassGenerationContext& Context, FFieldVariant Owner, const TSharedPtr<FJsonObject>& PropertyJson, EPropertyFlags ExtraPropertyFlags = CPF_None);
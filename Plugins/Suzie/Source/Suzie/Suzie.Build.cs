@@ -4,7 +4,14 @@ public class Suzie : ModuleRules
 	public Suzie(ReadOnlyTargetRules Target) : base(Target)
 	{
 		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
-		OptimizeCode = CodeOptimization.Never;
+
+		// Set to compile the module without optimization, to step through class generation in a debugger. Generation benchmarks warn when it is set
+		bool bDebugBuild = false;
+		if (bDebugBuild)
+		{
+			OptimizeCode = CodeOptimization.Never;
+		}
+		PrivateDefinitions.Add("SUZIE_DEBUG_BUILD=" + (bDebugBuild ? "1" : "0"));
 
 		PublicIncludePaths.AddRange(new string[] {}); 
 		
@@ -23,12 +30,14 @@ public class Suzie : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"AssetRegistry",
 				"Blutility",
 				"Json",
 				"UnrealEd",
 				"Projects",
 				"BlueprintGraph",
 				"zlib",
+				"DirectoryWatcher",
 			}
 			);
 